@@ -0,0 +1,70 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+
+#include "../src/Lexer.h"
+#include "../src/Token.h"
+#include "../src/TokenIndex.h"
+
+using namespace std;
+
+// Measures how much building a TokenIndex adds to Lexer::tokenize() on a large
+// generated source. Run with `make bench`.
+
+// Generates `functions` small functions drawing on a pool of identifiers, similar
+// in shape to machine-generated C--.
+string generate_source(int functions) {
+    string source;
+    for (int i = 0; i < functions; i++) {
+        string a = "v" + to_string(i % 97);
+        string b = "w" + to_string(i % 31);
+        source += "int f" + to_string(i) + "(int " + a + ", int " + b + ") {\n";
+        source += "    int tmp_" + to_string(i % 13) + ";\n";
+        source += "    while (" + a + " > 0) { " + a + " = " + a + " - 1; " + b + " = " + b + " + 2; }\n";
+        source += "    if (" + a + " == " + b + ") { output " + a + "; } else { output " + b + "; }\n";
+        source += "    return " + a + " * " + b + "; // result\n";
+        source += "}\n";
+    }
+    return source;
+}
+
+// Wall time of one call in milliseconds
+template <typename F>
+double time_ms(F&& body) {
+    auto start = chrono::steady_clock::now();
+    body();
+    auto stop = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(stop - start).count();
+}
+
+int main() {
+    // Plain and indexed runs alternate, so drift in machine load affects both
+    // sides alike; each side reports its best run.
+    const int runs = 15;
+    string source = generate_source(20000);
+    size_t token_count = 0;
+    TokenIndex index;
+
+    double plain_ms = 1e300;
+    double indexed_ms = 1e300;
+    for (int r = 0; r < runs; r++) {
+        plain_ms = min(plain_ms, time_ms([&]() {
+            Lexer lexer(source);
+            token_count = lexer.tokenize().size();
+        }));
+        indexed_ms = min(indexed_ms, time_ms([&]() {
+            Lexer lexer(source, &index);
+            token_count = lexer.tokenize().size();
+        }));
+    }
+
+    double overhead = (indexed_ms - plain_ms) / plain_ms * 100.0;
+    cout << "Source: " << source.size() << " bytes, " << token_count << " tokens, "
+         << index.distinctIdentifiers() << " distinct identifiers" << endl;
+    cout << "tokenize():              " << plain_ms << " ms" << endl;
+    cout << "tokenize() + TokenIndex: " << indexed_ms << " ms" << endl;
+    cout << "Index overhead:          " << overhead << " %" << endl;
+    return 0;
+}
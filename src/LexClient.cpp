@@ -0,0 +1,142 @@
+// Minimal client for the lexing daemon (`c-like-compiler --serve SOCKET`):
+//
+//     c-like-client SOCKET [--index] script_file
+//
+// Prints the same stdout/stderr and returns the same exit code as
+// `c-like-compiler [--index] script_file`. It only does socket I/O and the
+// framing described in Server.h, with no Lexer and no iostreams, so starting it
+// costs much less than starting the compiler itself.
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static void printError(const char* first, const char* second, const char* third) {
+    dprintf(STDERR_FILENO, "Error: %s%s%s\n", first, second, third);
+}
+
+static bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Buffered reads from the server socket
+struct Reader {
+    int fd;
+    char buffer[65536];
+    size_t pos = 0;
+    size_t end = 0;
+
+    bool fill() {
+        ssize_t n;
+        do {
+            n = read(fd, buffer, sizeof(buffer));
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) return false;
+        pos = 0;
+        end = static_cast<size_t>(n);
+        return true;
+    }
+
+    // Reads the response header line into `line` (without '\n')
+    bool readLine(char* line, size_t capacity) {
+        size_t length = 0;
+        while (true) {
+            if (pos == end && !fill()) return false;
+            char c = buffer[pos++];
+            if (c == '\n') break;
+            if (length + 1 >= capacity) return false;
+            line[length++] = c;
+        }
+        line[length] = '\0';
+        return true;
+    }
+
+    // Copies the next `length` bytes of the response to `out_fd`
+    bool copyTo(int out_fd, unsigned long long length) {
+        while (length > 0) {
+            if (pos == end && !fill()) return false;
+            size_t take = end - pos;
+            if (take > length) take = static_cast<size_t>(length);
+            if (!writeAll(out_fd, buffer + pos, take)) return false;
+            pos += take;
+            length -= take;
+        }
+        return true;
+    }
+};
+
+static Reader reader; // 64 KiB buffer, kept off the stack
+
+int main(int argc, char* argv[]) {
+    const char* socket_path = nullptr;
+    const char* path = nullptr;
+    bool with_index = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--index") == 0) {
+            with_index = true;
+        } else if (!socket_path) {
+            socket_path = argv[i];
+        } else if (!path) {
+            path = argv[i];
+        } else {
+            path = nullptr;
+            break;
+        }
+    }
+    if (!socket_path || !path) {
+        dprintf(STDERR_FILENO, "Usage: %s SOCKET [--index] script_file\n", argv[0]);
+        return 64;
+    }
+
+    // The server may run in another directory, so send an absolute path
+    char resolved[PATH_MAX];
+    if (!realpath(path, resolved)) {
+        printError("Could not open file '", path, "'");
+        return 66;
+    }
+
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        printError("Socket path '", socket_path, "' is too long");
+        return 64;
+    }
+    strcpy(addr.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        dprintf(STDERR_FILENO, "Error: Could not connect to server at '%s': %s\n", socket_path, strerror(errno));
+        return 69;
+    }
+
+    char header[64];
+    int header_length = snprintf(header, sizeof(header), "FILE %zu %d\n", strlen(resolved), with_index ? 1 : 0);
+    reader.fd = fd;
+    char line[64];
+    int exit_code = 0;
+    unsigned long long out_length = 0, err_length = 0;
+    bool ok = writeAll(fd, header, static_cast<size_t>(header_length)) &&
+              writeAll(fd, resolved, strlen(resolved)) &&
+              reader.readLine(line, sizeof(line)) &&
+              sscanf(line, "%d %llu %llu", &exit_code, &out_length, &err_length) == 3 &&
+              reader.copyTo(STDOUT_FILENO, out_length) &&
+              reader.copyTo(STDERR_FILENO, err_length);
+    close(fd);
+    if (!ok) {
+        printError("Lost connection to server at '", socket_path, "'");
+        return 69;
+    }
+    return exit_code;
+}
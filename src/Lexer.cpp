@@ -1,10 +1,10 @@
 #include "Lexer.h"
+#include "StaticLexer.h" // Shared keyword table and character classes
 #include <iostream>
 #include <stdexcept>
-#include <cctype>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <map>
 #include <any>
 #include <cstddef>
 
@@ -18,31 +18,24 @@ void reportLexerError(int line, int column, const string& message) {
     had_lexer_error = true;
 }
 
-// Static members initialization
-const map<string, TokenType> Lexer::keywords = Lexer::createKeywordsMap();
-
-map<string, TokenType> Lexer::createKeywordsMap() {
-    map<string, TokenType> map;
-    map["int"]    = KEYWORD_INT;
-    map["void"]   = KEYWORD_VOID;
-    map["if"]     = KEYWORD_IF;
-    map["else"]   = KEYWORD_ELSE;
-    map["while"]  = KEYWORD_WHILE;
-    map["return"] = KEYWORD_RETURN;
-    map["input"]  = KEYWORD_INPUT;
-    map["output"] = KEYWORD_OUTPUT;
-    return map;
+// Per-lexer error reporting: goes to the error sink if one is set
+void Lexer::error(int line, int column, const string& message) {
+    if (error_sink) {
+        error_sink->push_back("[Lexer Error] line " + to_string(line) + ", col " + to_string(column) + ": " + message);
+    } else {
+        reportLexerError(line, column, message);
+    }
 }
 
-
 // Lexer Class Implementation
-Lexer::Lexer(const string& source) : source_code(source) {
+Lexer::Lexer(const string& source, TokenIndex* index) : source_code(source), index(index) {
     column = 0; // Initialize to 0 for 0-based indexing
     current_token_start_column = 1; // Always 1-based for reporting
 }
 
 vector<Token> Lexer::tokenize() {
     tokens.clear();
+    if (index) index->clear();
     current_char_idx = 0;
     line = 1;
     column = 0;
@@ -65,6 +58,7 @@ vector<Token> Lexer::tokenize() {
     }
 
     tokens.emplace_back(EOF_TOKEN, "", any(), line, column + 1);
+    if (index) index->add(EOF_TOKEN, tokens.back().value, tokens.size() - 1);
     return tokens;
 }
 
@@ -93,6 +87,7 @@ void Lexer::addToken(TokenType type) {
 void Lexer::addToken(TokenType type, any literal_value) {
     string lexeme = source_code.substr(start_lexeme_idx, current_char_idx - start_lexeme_idx);
     tokens.emplace_back(type, lexeme, literal_value, line, current_token_start_column);
+    if (index) index->add(type, tokens.back().value, tokens.size() - 1);
 }
 
 void Lexer::skipWhitespaceAndComments() {
@@ -132,7 +127,7 @@ void Lexer::skipWhitespaceAndComments() {
 
 void Lexer::readNumber() {
     // Current 'column' is 0-based.
-    while (isdigit(peek())) {
+    while (isStaticDigit(peek())) {
         advance();
         column++;
     }
@@ -141,27 +136,22 @@ void Lexer::readNumber() {
         int num_val = stoi(num_str);
         addToken(NUMBER, num_val); // addToken uses current_token_start_column
     } catch (const out_of_range& e) {
-        reportLexerError(line, current_token_start_column, "Number literal '" + num_str + "' is too large.");
+        error(line, current_token_start_column, "Number literal '" + num_str + "' is too large.");
         addToken(NUMBER, 0);
     } catch (const invalid_argument& e) {
-        reportLexerError(line, current_token_start_column, "Invalid number literal: '" + num_str + "'");
+        error(line, current_token_start_column, "Invalid number literal: '" + num_str + "'");
         addToken(NUMBER, 0);
     }
 }
 
 void Lexer::readIdentifierOrKeyword() {
     // Current 'column' is 0-based.
-    while (isalnum(peek()) || peek() == '_') {
+    while (isStaticIdentChar(peek())) {
         advance(); 
         column++;  
     }
-    string text = source_code.substr(start_lexeme_idx, current_char_idx - start_lexeme_idx);
-    auto it = keywords.find(text);
-    if (it != keywords.end()) {
-        addToken(it->second);
-    } else {
-        addToken(IDENTIFIER);
-    }
+    string_view text(source_code.data() + start_lexeme_idx, current_char_idx - start_lexeme_idx);
+    addToken(lookupStaticKeyword(text)); // IDENTIFIER unless text is a keyword
 }
 
 
@@ -196,7 +186,7 @@ void Lexer::scanToken() {
             if (match('=')) {
                 addToken(OP_NOT_EQUAL);
             } else {
-                reportLexerError(line, current_token_start_column, "Unexpected character '!' (expected '!=')");
+                error(line, current_token_start_column, "Unexpected character '!' (expected '!=')");
             }
             break;
         case '=': addToken(match('=') ? OP_EQUAL : OP_ASSIGN); break;
@@ -204,12 +194,12 @@ void Lexer::scanToken() {
         case '>': addToken(match('=') ? OP_GREATER_EQUAL : OP_GREATER); break;
 
         default:
-            if (isdigit(c)) {
+            if (isStaticDigit(c)) {
                 readNumber(); // These methods handle their own column increments
-            } else if (isalpha(c) || c == '_') {
+            } else if (isStaticAlpha(c) || c == '_') {
                 readIdentifierOrKeyword(); // These methods handle their own column increments
             } else {
-                reportLexerError(line, current_token_start_column, "Unexpected character '" + string(1, c) + "'");
+                error(line, current_token_start_column, "Unexpected character '" + string(1, c) + "'");
             }
             break;
     }
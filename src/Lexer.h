@@ -2,22 +2,31 @@
 
 #include <string>
 #include <vector>
-#include <map>
 #include <any>
 #include "Token.h"
+#include "TokenIndex.h"
 
 // Define a simple error reporting function similar to Lox's `Lox::error`
 void reportLexerError(int line, int column, const std::string& message);
 
 class Lexer {
 public:
-    Lexer(const std::string& source);
+    // If `index` is given, tokenize() also fills it with identifier occurrences
+    // and per-TokenType counts for the returned tokens.
+    Lexer(const std::string& source, TokenIndex* index = nullptr);
+
+    // If set, lexical errors are appended to `sink` (formatted like
+    // reportLexerError) instead of going to stderr and had_lexer_error.
+    // Lets several lexers run on different threads at once.
+    void setErrorSink(std::vector<std::string>* sink) { error_sink = sink; }
 
     std::vector<Token> tokenize();
 
 private:
     const std::string source_code;
     std::vector<Token> tokens;
+    TokenIndex* index; // Optional, not owned
+    std::vector<std::string>* error_sink = nullptr; // Optional, not owned
 
     // Position tracking:
     // current_char_idx: Current index in source_code (points to the character *to be consumed next*)
@@ -38,9 +47,6 @@ private:
     // This is captured once at the start of scanToken() for the token being built.
     int current_token_start_column = 1; 
 
-    static const std::map<std::string, TokenType> keywords;
-    static std::map<std::string, TokenType> createKeywordsMap();
-
     bool isAtEnd() const;
     // advance() now only moves current_char_idx; column update is external or by skip/scan
     char advance(); 
@@ -56,4 +62,5 @@ private:
     void readNumber();
     void readIdentifierOrKeyword();
     bool match(char expected); // Conditional advance for two-character operators
+    void error(int line, int column, const std::string& message);
 };
\ No newline at end of file
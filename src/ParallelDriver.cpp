@@ -0,0 +1,158 @@
+#include "ParallelDriver.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+
+using namespace std;
+
+// Formats a structural diagnostic the same way reportLexerError() does.
+static string structureError(const Token& token, const string& message) {
+    return "[Structure Error] line " + to_string(token.line) + ", col " +
+           to_string(token.column) + ": " + message;
+}
+
+static TokenType closerFor(TokenType opener) {
+    switch (opener) {
+        case DELIM_LPAREN: return DELIM_RPAREN;
+        case DELIM_LBRACKET: return DELIM_RBRACKET;
+        default: return DELIM_RBRACE;
+    }
+}
+
+vector<TopLevelUnit> splitTopLevelUnits(const vector<Token>& tokens) {
+    vector<TopLevelUnit> units;
+    size_t unit_start = 0;
+    int depth = 0;
+    bool saw_brace = false;
+
+    for (size_t i = 0; i < tokens.size(); i++) {
+        TokenType type = tokens[i].type;
+        if (type == EOF_TOKEN) {
+            break;
+        }
+
+        if (type == DELIM_LBRACE) {
+            depth++;
+            saw_brace = true;
+        } else if (type == DELIM_RBRACE) {
+            // A stray '}' at depth 0 closes the current unit; checkUnit() reports it.
+            if (depth > 0) depth--;
+            if (depth == 0) {
+                units.push_back({unit_start, i + 1, true});
+                unit_start = i + 1;
+                saw_brace = false;
+            }
+        } else if (type == DELIM_SEMICOLON && depth == 0) {
+            units.push_back({unit_start, i + 1, saw_brace});
+            unit_start = i + 1;
+            saw_brace = false;
+        }
+    }
+
+    // Trailing tokens without a terminator still form a unit so they get checked.
+    size_t end = tokens.size();
+    if (end > 0 && tokens[end - 1].type == EOF_TOKEN) end--;
+    if (unit_start < end) {
+        units.push_back({unit_start, end, saw_brace});
+    }
+    return units;
+}
+
+UnitResult checkUnit(const vector<Token>& tokens, const TopLevelUnit& unit) {
+    UnitResult result;
+
+    for (size_t i = unit.begin; i < unit.end; i++) {
+        result.output += tokens[i].toString();
+        result.output += '\n';
+    }
+
+    if (unit.is_function) {
+        // Expected header: (int|void) IDENTIFIER ( ... ) {
+        const Token& first = tokens[unit.begin];
+        if (first.type != KEYWORD_INT && first.type != KEYWORD_VOID) {
+            result.diagnostics.push_back(structureError(first, "Function must start with a return type ('int' or 'void')"));
+        } else if (unit.begin + 1 >= unit.end || tokens[unit.begin + 1].type != IDENTIFIER) {
+            result.diagnostics.push_back(structureError(first, "Expected function name after return type"));
+        } else if (unit.begin + 2 >= unit.end || tokens[unit.begin + 2].type != DELIM_LPAREN) {
+            result.diagnostics.push_back(structureError(tokens[unit.begin + 1], "Expected '(' after function name"));
+        } else {
+            for (size_t i = unit.begin + 3; i < unit.end; i++) {
+                if (tokens[i].type == DELIM_LBRACE) {
+                    if (tokens[i - 1].type != DELIM_RPAREN) {
+                        result.diagnostics.push_back(structureError(tokens[i], "Expected ')' before function body"));
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    // Bracket nesting within the unit.
+    vector<size_t> open;
+    for (size_t i = unit.begin; i < unit.end; i++) {
+        TokenType type = tokens[i].type;
+        if (type == DELIM_LPAREN || type == DELIM_LBRACKET || type == DELIM_LBRACE) {
+            open.push_back(i);
+        } else if (type == DELIM_RPAREN || type == DELIM_RBRACKET || type == DELIM_RBRACE) {
+            if (open.empty()) {
+                result.diagnostics.push_back(structureError(tokens[i], "Unmatched '" + tokens[i].value + "'"));
+            } else if (closerFor(tokens[open.back()].type) != type) {
+                result.diagnostics.push_back(structureError(tokens[i], "Mismatched '" + tokens[i].value +
+                                                            "' (opened by '" + tokens[open.back()].value + "')"));
+                open.pop_back();
+            } else {
+                open.pop_back();
+            }
+        }
+    }
+    for (size_t idx : open) {
+        result.diagnostics.push_back(structureError(tokens[idx], "Unclosed '" + tokens[idx].value + "'"));
+    }
+
+    return result;
+}
+
+unsigned effectiveJobs(unsigned jobs, size_t unit_count) {
+    if (jobs == 0) {
+        jobs = max(1u, thread::hardware_concurrency());
+    }
+    jobs = min(jobs, kMaxParallelJobs);
+    return static_cast<unsigned>(max<size_t>(1, min<size_t>(jobs, unit_count)));
+}
+
+vector<UnitResult> checkUnitsParallel(const vector<Token>& tokens,
+                                      const vector<TopLevelUnit>& units,
+                                      unsigned jobs) {
+    vector<UnitResult> results(units.size());
+    jobs = effectiveJobs(jobs, units.size());
+
+    // Workers pull the next unchecked unit from a shared counter, so a few very
+    // long functions don't leave the other threads idle.
+    atomic<size_t> next_unit(0);
+    auto worker = [&]() {
+        while (true) {
+            size_t i = next_unit.fetch_add(1, memory_order_relaxed);
+            if (i >= units.size()) return;
+            results[i] = checkUnit(tokens, units[i]);
+        }
+    };
+
+    if (jobs <= 1) {
+        worker();
+        return results;
+    }
+
+    vector<thread> pool;
+    pool.reserve(jobs - 1);
+    for (unsigned t = 1; t < jobs; t++) {
+        pool.emplace_back(worker);
+    }
+    worker(); // The calling thread takes part as well
+    for (auto& th : pool) {
+        th.join();
+    }
+    return results;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "Token.h"
+
+// TopLevelUnit: A half-open range [begin, end) of token indices that forms one
+// top-level declaration (a function definition or a global declaration).
+struct TopLevelUnit {
+    size_t begin;
+    size_t end;
+    bool is_function; // true if the unit contains a brace-delimited body
+};
+
+// UnitResult: Everything produced while checking one unit. Workers only write
+// into their own UnitResult, so results can be merged in source order afterwards.
+struct UnitResult {
+    std::string output;                    // Token dump for the unit's tokens
+    std::vector<std::string> diagnostics;  // Structural errors, in token order
+};
+
+// Splits the token stream into top-level units with a single linear scan over
+// DELIM_LBRACE/DELIM_RBRACE depth. A unit ends at a ';' or '}' seen at depth 0.
+// The trailing EOF_TOKEN is never part of a unit.
+std::vector<TopLevelUnit> splitTopLevelUnits(const std::vector<Token>& tokens);
+
+// Checks a single unit: bracket nesting within the unit and, for function
+// units, the `type name ( ... ) { ... }` header shape.
+UnitResult checkUnit(const std::vector<Token>& tokens, const TopLevelUnit& unit);
+
+// Upper bound on worker threads, so a huge --jobs value can't exhaust the process.
+const unsigned kMaxParallelJobs = 256;
+
+// Number of threads checkUnitsParallel() starts for `jobs` (0 picks the hardware
+// thread count): never more than `unit_count` or kMaxParallelJobs, at least 1.
+unsigned effectiveJobs(unsigned jobs, size_t unit_count);
+
+// Checks every unit on effectiveJobs(jobs, units.size()) threads.
+// The returned vector is indexed like `units`, so output is independent of `jobs`.
+std::vector<UnitResult> checkUnitsParallel(const std::vector<Token>& tokens,
+                                           const std::vector<TopLevelUnit>& units,
+                                           unsigned jobs);
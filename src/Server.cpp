@@ -0,0 +1,812 @@
+#include "Server.h"
+#include "Lexer.h"
+#include "Token.h"
+#include "TokenIndex.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+// --- Framing helpers ---
+
+static const size_t kMaxHeaderBytes = 64;
+static const unsigned long long kMaxPayloadBytes = 1ull << 30;
+
+// Buffered blocking reader over a file descriptor, used by the client side
+class FdReader {
+public:
+    explicit FdReader(int fd) : fd(fd) {}
+
+    // Reads up to and excluding '\n'. Returns false on EOF or error.
+    bool readLine(string& line) {
+        line.clear();
+        while (true) {
+            size_t newline = buffer.find('\n', pos);
+            if (newline != string::npos) {
+                line.append(buffer, pos, newline - pos);
+                pos = newline + 1;
+                return true;
+            }
+            line.append(buffer, pos, string::npos);
+            pos = buffer.size();
+            if (!fill()) return false;
+        }
+    }
+
+    bool readExact(size_t n, string& out) {
+        out.clear();
+        while (out.size() < n) {
+            if (pos == buffer.size() && !fill()) return false;
+            size_t take = min(n - out.size(), buffer.size() - pos);
+            out.append(buffer, pos, take);
+            pos += take;
+        }
+        return true;
+    }
+
+private:
+    int fd;
+    string buffer;
+    size_t pos = 0;
+
+    bool fill() {
+        char chunk[65536];
+        ssize_t n;
+        do {
+            n = read(fd, chunk, sizeof(chunk));
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) return false;
+        buffer.assign(chunk, static_cast<size_t>(n));
+        pos = 0;
+        return true;
+    }
+};
+
+static bool writeAll(int fd, const char* data, size_t n) {
+    while (n > 0) {
+        ssize_t written = write(fd, data, n);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        n -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+static bool writeAll(int fd, const string& data) {
+    return writeAll(fd, data.data(), data.size());
+}
+
+// Parses one request frame starting at buffer[pos]. Returns 1 and advances
+// `pos` past the frame if it is complete, 0 if more bytes are needed, -1 if
+// the frame is malformed.
+static int parseRequest(const string& buffer, size_t& pos, LexRequest& request) {
+    size_t newline = buffer.find('\n', pos);
+    if (newline == string::npos) {
+        return buffer.size() - pos > kMaxHeaderBytes ? -1 : 0;
+    }
+    size_t header_length = newline - pos;
+    if (header_length > kMaxHeaderBytes) return -1;
+
+    char header[kMaxHeaderBytes + 1];
+    memcpy(header, buffer.data() + pos, header_length);
+    header[header_length] = '\0';
+
+    char kind[8];
+    unsigned long long length = 0;
+    int with_index = 0;
+    int consumed = 0;
+    if (sscanf(header, "%7s %llu %d%n", kind, &length, &with_index, &consumed) != 3 ||
+        header[consumed] != '\0' || length > kMaxPayloadBytes) {
+        return -1;
+    }
+    if (strcmp(kind, "SOURCE") == 0) {
+        request.kind = REQUEST_SOURCE;
+    } else if (strcmp(kind, "FILE") == 0) {
+        request.kind = REQUEST_FILE;
+    } else {
+        return -1;
+    }
+
+    size_t payload_start = newline + 1;
+    if (buffer.size() - payload_start < length) return 0;
+    request.payload.assign(buffer, payload_start, length);
+    request.with_index = with_index != 0;
+    pos = payload_start + length;
+    return 1;
+}
+
+static void appendResponse(string& out, const LexResponse& response) {
+    char header[64];
+    int n = snprintf(header, sizeof(header), "%d %zu %zu\n", response.exit_code,
+                     response.out.size(), response.err.size());
+    out.append(header, static_cast<size_t>(n));
+    out += response.out;
+    out += response.err;
+}
+
+static bool makeSocketAddress(const string& socket_path, sockaddr_un& addr) {
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        cerr << "Error: Socket path too long '" << socket_path << "'" << endl;
+        return false;
+    }
+    strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    return true;
+}
+
+static void setNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+// --- Request handling ---
+
+// Reads a whole file into `buffer`, keeping the buffer's capacity. Anything
+// that is not a regular file (FIFO, directory) is read like main() reads it.
+static bool readFileInto(const string& path, string& buffer) {
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return false;
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+        stringstream contents;
+        contents << file.rdbuf();
+        buffer = contents.str();
+        return true;
+    }
+    buffer.resize(static_cast<size_t>(info.st_size));
+    file.read(&buffer[0], info.st_size);
+    buffer.resize(static_cast<size_t>(file.gcount())); // File may have shrunk
+    return true;
+}
+
+void handleRequest(const LexRequest& request, LexResponse& response) {
+    // Per-thread state that keeps its capacity from one request to the next
+    thread_local string file_buffer;
+    thread_local TokenIndex index;
+    thread_local vector<string> errors;
+    thread_local ostringstream index_text;
+
+    response.exit_code = 0;
+    response.out.clear();
+    response.err.clear();
+    errors.clear();
+
+    const string* source = &request.payload;
+    if (request.kind == REQUEST_FILE) {
+        if (!readFileInto(request.payload, file_buffer)) {
+            response.err = "Error: Could not open file '" + request.payload + "'\n";
+            response.exit_code = 66;
+            return;
+        }
+        source = &file_buffer;
+    }
+
+    Lexer lexer(*source, request.with_index ? &index : nullptr);
+    lexer.setErrorSink(&errors);
+    vector<Token> tokens = lexer.tokenize();
+
+    for (const auto& token : tokens) {
+        response.out += token.toString();
+        response.out += '\n';
+    }
+    if (request.with_index) {
+        index_text.str("");
+        index.write(index_text);
+        response.out += index_text.str();
+    }
+
+    for (const auto& error : errors) {
+        response.err += error;
+        response.err += '\n';
+    }
+    if (!errors.empty()) {
+        response.exit_code = 65;
+    }
+}
+
+bool sendRequest(int fd, const LexRequest& request, LexResponse& response) {
+    string header = string(request.kind == REQUEST_FILE ? "FILE" : "SOURCE") + " " +
+                    to_string(request.payload.size()) + " " + (request.with_index ? "1" : "0") + "\n";
+    if (!writeAll(fd, header) || !writeAll(fd, request.payload)) return false;
+
+    FdReader reader(fd);
+    string line;
+    if (!reader.readLine(line)) return false;
+    istringstream fields(line);
+    size_t out_length = 0, err_length = 0;
+    if (!(fields >> response.exit_code >> out_length >> err_length)) return false;
+    return reader.readExact(out_length, response.out) && reader.readExact(err_length, response.err);
+}
+
+// --- Server ---
+
+// Fixed set of threads running queued tasks in FIFO order
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned workers) {
+        for (unsigned i = 0; i < workers; i++) {
+            threads.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    // Finishes every queued task, then joins the workers
+    ~WorkerPool() {
+        {
+            lock_guard<mutex> lock(m);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto& th : threads) {
+            th.join();
+        }
+    }
+
+    void submit(function<void()> task) {
+        {
+            lock_guard<mutex> lock(m);
+            tasks.push_back(move(task));
+        }
+        cv.notify_one();
+    }
+
+private:
+    vector<thread> threads;
+    deque<function<void()>> tasks;
+    mutex m;
+    condition_variable cv;
+    bool stopping = false;
+
+    void workerLoop() {
+        while (true) {
+            function<void()> task;
+            {
+                unique_lock<mutex> lock(m);
+                cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+// Stop requests reach the event loop through its self-pipe, so a signal that
+// arrives at any point (even just before poll()) still wakes it up.
+static atomic<bool> stop_requested(false);
+static atomic<int> wake_fd(-1); // Write end of the running loop's self-pipe
+
+void requestServerStop() {
+    stop_requested = true;
+    int fd = wake_fd.load();
+    if (fd >= 0) {
+        ssize_t ignored = write(fd, "s", 1);
+        (void)ignored; // A full pipe already guarantees a wakeup
+    }
+}
+
+static void onStopSignal(int) {
+    int saved_errno = errno;
+    requestServerStop();
+    errno = saved_errno;
+}
+
+// The I/O side of one client: the event loop reads and parses request frames
+// itself and only hands complete requests to the worker pool, so a client that
+// sends nothing never occupies a worker.
+struct Connection;
+
+struct RequestSlot {
+    LexRequest request;
+    LexResponse response;
+    Connection* connection = nullptr;
+    unsigned long long sequence = 0;
+};
+
+struct Connection {
+    int in_fd = -1;
+    int out_fd = -1;
+    bool owns_fd = false;         // Socket connections are closed by the server
+    bool timeout_enabled = false; // Not for stdio: scripts may keep the pipe idle
+
+    string in_buffer;
+    size_t in_pos = 0;
+    string out_buffer;
+    size_t out_pos = 0;
+
+    unsigned long long next_sequence = 0; // Assigned to the next parsed request
+    unsigned long long next_to_send = 0;  // Responses go out in request order
+    map<unsigned long long, RequestSlot*> finished;
+    size_t in_flight = 0;
+
+    bool read_closed = false;
+    bool malformed = false;
+    bool write_failed = false;
+    bool closed = false; // Descriptors released; waiting for in-flight requests
+    chrono::steady_clock::time_point last_activity = chrono::steady_clock::now();
+
+    bool hasOutput() const { return out_pos < out_buffer.size(); }
+};
+
+class LexServer {
+public:
+    LexServer(unsigned workers, int read_timeout_ms)
+        : read_timeout(read_timeout_ms),
+          max_in_flight(2 * max(1u, workers)),
+          pool(new WorkerPool(max(1u, workers))) {}
+
+    ~LexServer() {
+        if (wake_pipe[0] >= 0) close(wake_pipe[0]);
+        if (wake_pipe[1] >= 0) close(wake_pipe[1]);
+    }
+
+    bool openWakePipe() {
+        if (pipe(wake_pipe) != 0) {
+            cerr << "Error: Could not create pipe: " << strerror(errno) << endl;
+            return false;
+        }
+        setNonBlocking(wake_pipe[0]);
+        setNonBlocking(wake_pipe[1]);
+        wake_fd = wake_pipe[1];
+        return true;
+    }
+
+    Connection* addConnection(int in_fd, int out_fd, bool owns_fd, bool timeout_enabled) {
+        connections.emplace_back(new Connection());
+        Connection* connection = connections.back().get();
+        connection->in_fd = in_fd;
+        connection->out_fd = out_fd;
+        connection->owns_fd = owns_fd;
+        connection->timeout_enabled = timeout_enabled;
+        return connection;
+    }
+
+    // Runs until stopped, or (without a listening socket) until every connection
+    // has finished.
+    void run(int listen_fd) {
+        // One pollfd per descriptor; `polled` says which connection and which
+        // direction each entry past the wake pipe and listener belongs to.
+        struct Polled { Connection* connection; bool in; bool out; };
+        vector<pollfd> fds;
+        vector<Polled> polled;
+
+        while (!stop_requested) {
+            if (listen_fd < 0 && connections.empty()) break;
+
+            fds.clear();
+            polled.clear();
+            fds.push_back({wake_pipe[0], POLLIN, 0});
+            if (listen_fd >= 0) fds.push_back({listen_fd, POLLIN, 0});
+            size_t first_connection = fds.size();
+            for (auto& owned : connections) {
+                Connection* c = owned.get();
+                if (c->closed) continue;
+                bool want_in = !c->read_closed && c->in_flight < max_in_flight;
+                bool want_out = c->hasOutput();
+                if (c->in_fd == c->out_fd) {
+                    addPollEntry(fds, polled, {c, want_in, want_out}, c->in_fd);
+                } else {
+                    addPollEntry(fds, polled, {c, want_in, false}, c->in_fd);
+                    addPollEntry(fds, polled, {c, false, want_out}, c->out_fd);
+                }
+            }
+
+            if (poll(fds.data(), fds.size(), pollTimeoutMs()) < 0 && errno != EINTR) {
+                cerr << "Error: poll failed: " << strerror(errno) << endl;
+                break;
+            }
+
+            drainWakePipe();
+            collectFinished();
+            if (listen_fd >= 0 && (fds[1].revents & POLLIN)) {
+                acceptConnections(listen_fd);
+            }
+            for (size_t i = first_connection; i < fds.size(); i++) {
+                const Polled& entry = polled[i - first_connection];
+                Connection& c = *entry.connection;
+                if (c.closed) continue;
+                if (entry.in && !c.read_closed && (fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                    readFrom(c);
+                }
+                if (entry.out && (fds[i].revents & (POLLOUT | POLLHUP | POLLERR))) {
+                    writeTo(c);
+                }
+            }
+            closeFinishedConnections();
+        }
+
+        // Shutting down: wake up any client blocked on us, let in-flight
+        // requests finish, then release everything.
+        for (auto& owned : connections) {
+            if (!owned->closed && owned->owns_fd) shutdown(owned->in_fd, SHUT_RDWR);
+        }
+        pool.reset();
+        collectFinished();
+        for (auto& owned : connections) {
+            release(*owned);
+        }
+        connections.clear();
+        wake_fd = -1;
+    }
+
+    bool hadMalformedRequest() const { return malformed_seen; }
+    bool hadWriteFailure() const { return write_failure_seen; }
+
+private:
+    int wake_pipe[2] = {-1, -1};
+    chrono::milliseconds read_timeout;
+    size_t max_in_flight; // Per connection, bounds buffered responses
+    unique_ptr<WorkerPool> pool;
+    list<unique_ptr<Connection>> connections;
+    vector<unique_ptr<RequestSlot>> free_slots; // Reused, so their strings stay allocated
+    char read_chunk[65536];
+    bool malformed_seen = false;
+    bool write_failure_seen = false;
+
+    mutex finished_mutex;
+    vector<RequestSlot*> finished_slots; // Filled by workers, drained by the loop
+
+    // Entries with nothing to wait for get fd -1, so poll() ignores them instead
+    // of reporting POLLHUP on a finished input over and over.
+    template <typename Entry>
+    static void addPollEntry(vector<pollfd>& fds, vector<Entry>& polled, Entry entry, int fd) {
+        short events = static_cast<short>((entry.in ? POLLIN : 0) | (entry.out ? POLLOUT : 0));
+        fds.push_back({events != 0 ? fd : -1, events, 0});
+        polled.push_back(entry);
+    }
+
+    int pollTimeoutMs() const {
+        if (read_timeout.count() <= 0) return -1;
+        auto now = chrono::steady_clock::now();
+        long long best = -1;
+        for (const auto& owned : connections) {
+            const Connection& c = *owned;
+            if (!isWaitingOnClient(c)) continue;
+            auto left = chrono::duration_cast<chrono::milliseconds>(c.last_activity + read_timeout - now).count();
+            left = max<long long>(left, 0);
+            if (best < 0 || left < best) best = left;
+        }
+        return static_cast<int>(best);
+    }
+
+    static bool isWaitingOnClient(const Connection& c) {
+        return c.timeout_enabled && !c.closed && !c.read_closed && c.in_flight == 0 && !c.hasOutput();
+    }
+
+    void drainWakePipe() {
+        char drain[256];
+        while (read(wake_pipe[0], drain, sizeof(drain)) > 0) {
+        }
+    }
+
+    void acceptConnections(int listen_fd) {
+        while (true) {
+            int fd = accept(listen_fd, nullptr, nullptr);
+            if (fd < 0) {
+                if (errno == EINTR) continue;
+                return; // EAGAIN, or a transient error; poll() tells us when to retry
+            }
+            setNonBlocking(fd);
+            addConnection(fd, fd, true, true);
+        }
+    }
+
+    void readFrom(Connection& c) {
+        ssize_t n;
+        do {
+            n = read(c.in_fd, read_chunk, sizeof(read_chunk));
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            c.read_closed = true;
+            return;
+        }
+        if (n == 0) {
+            c.read_closed = true;
+        } else {
+            c.in_buffer.append(read_chunk, static_cast<size_t>(n));
+            c.last_activity = chrono::steady_clock::now();
+        }
+        submitBufferedRequests(c);
+    }
+
+    void submitBufferedRequests(Connection& c) {
+        while (c.in_flight < max_in_flight && !c.malformed) {
+            RequestSlot* slot = takeSlot();
+            int status = parseRequest(c.in_buffer, c.in_pos, slot->request);
+            if (status <= 0) {
+                free_slots.emplace_back(slot);
+                if (status < 0) c.malformed = true;
+                break;
+            }
+            slot->connection = &c;
+            slot->sequence = c.next_sequence++;
+            c.in_flight++;
+            pool->submit([this, slot]() {
+                handleRequest(slot->request, slot->response);
+                {
+                    lock_guard<mutex> lock(finished_mutex);
+                    finished_slots.push_back(slot);
+                }
+                ssize_t ignored = write(wake_pipe[1], "w", 1);
+                (void)ignored; // A full pipe already guarantees a wakeup
+            });
+        }
+
+        // Drop consumed bytes once they dominate the buffer
+        if (c.in_pos == c.in_buffer.size()) {
+            c.in_buffer.clear();
+            c.in_pos = 0;
+        } else if (c.in_pos > 65536 && c.in_pos * 2 > c.in_buffer.size()) {
+            c.in_buffer.erase(0, c.in_pos);
+            c.in_pos = 0;
+        }
+        // EOF in the middle of a frame
+        if (c.read_closed && c.in_pos < c.in_buffer.size() && c.in_flight < max_in_flight) {
+            c.malformed = true;
+        }
+    }
+
+    RequestSlot* takeSlot() {
+        if (free_slots.empty()) return new RequestSlot();
+        RequestSlot* slot = free_slots.back().release();
+        free_slots.pop_back();
+        return slot;
+    }
+
+    void collectFinished() {
+        vector<RequestSlot*> done;
+        {
+            lock_guard<mutex> lock(finished_mutex);
+            done.swap(finished_slots);
+        }
+        for (RequestSlot* slot : done) {
+            Connection& c = *slot->connection;
+            c.in_flight--;
+            if (c.closed) {
+                free_slots.emplace_back(slot);
+                continue;
+            }
+            c.finished[slot->sequence] = slot;
+            // Queue every response that is next in request order
+            for (auto it = c.finished.begin(); it != c.finished.end() && it->first == c.next_to_send;
+                 it = c.finished.erase(it)) {
+                appendResponse(c.out_buffer, it->second->response);
+                free_slots.emplace_back(it->second);
+                c.next_to_send++;
+            }
+            submitBufferedRequests(c); // Requests held back by max_in_flight
+            if (c.owns_fd) writeTo(c); // Non-blocking; others wait for POLLOUT
+        }
+    }
+
+    void writeTo(Connection& c) {
+        while (c.hasOutput()) {
+            size_t n = c.out_buffer.size() - c.out_pos;
+            // A descriptor we don't own stays blocking; POLLOUT guarantees room
+            // for PIPE_BUF bytes, so larger writes could stall the loop.
+            if (!c.owns_fd) n = min<size_t>(n, PIPE_BUF);
+            ssize_t written = write(c.out_fd, c.out_buffer.data() + c.out_pos, n);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK) c.write_failed = true;
+                return;
+            }
+            c.out_pos += static_cast<size_t>(written);
+            if (!c.owns_fd) return; // Wait for the next POLLOUT
+        }
+        c.out_buffer.clear();
+        c.out_pos = 0;
+        c.last_activity = chrono::steady_clock::now();
+    }
+
+    void closeFinishedConnections() {
+        auto now = chrono::steady_clock::now();
+        for (auto it = connections.begin(); it != connections.end();) {
+            Connection& c = **it;
+            if (!c.closed) {
+                bool done = c.read_closed && c.in_flight == 0 && c.finished.empty() && !c.hasOutput();
+                bool timed_out = read_timeout.count() > 0 && isWaitingOnClient(c) &&
+                                 now - c.last_activity >= read_timeout;
+                if (c.malformed && c.in_flight == 0 && !c.hasOutput()) done = true;
+                if (done || timed_out || c.write_failed) {
+                    malformed_seen |= c.malformed;
+                    write_failure_seen |= c.write_failed;
+                    release(c);
+                }
+            }
+            if (c.closed && c.in_flight == 0) {
+                it = connections.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void release(Connection& c) {
+        if (c.closed) return;
+        c.closed = true;
+        if (c.owns_fd) {
+            close(c.in_fd);
+            if (c.out_fd != c.in_fd) close(c.out_fd);
+        }
+        for (auto& entry : c.finished) {
+            free_slots.emplace_back(entry.second);
+        }
+        c.finished.clear();
+    }
+};
+
+static int serveStreamUntilStopped(int in_fd, int out_fd, unsigned workers) {
+    if (workers == 0) {
+        workers = max(1u, thread::hardware_concurrency());
+    }
+    LexServer server(workers, 0);
+    if (!server.openWakePipe()) return 71;
+    server.addConnection(in_fd, out_fd, false, false);
+    server.run(-1);
+
+    if (server.hadMalformedRequest()) {
+        cerr << "Error: Malformed request" << endl;
+        return 65;
+    }
+    return server.hadWriteFailure() ? 74 : 0;
+}
+
+int serveStream(int in_fd, int out_fd, unsigned workers) {
+    stop_requested = false;
+    return serveStreamUntilStopped(in_fd, out_fd, workers);
+}
+
+// Makes sure binding `socket_path` can't destroy anything: only a stale socket
+// (one nobody answers on) may be removed.
+static bool prepareSocketPath(const string& socket_path, const sockaddr_un& addr) {
+    struct stat info;
+    if (lstat(socket_path.c_str(), &info) != 0) {
+        return errno == ENOENT;
+    }
+    if (!S_ISSOCK(info.st_mode)) {
+        cerr << "Error: '" << socket_path << "' exists and is not a socket; refusing to replace it" << endl;
+        return false;
+    }
+
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) return false;
+    bool in_use = connect(probe, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0;
+    close(probe);
+    if (in_use) {
+        cerr << "Error: A server is already listening on '" << socket_path << "'" << endl;
+        return false;
+    }
+    return unlink(socket_path.c_str()) == 0;
+}
+
+int runServer(const string& socket_path, unsigned workers, int read_timeout_ms) {
+    if (workers == 0) {
+        workers = max(1u, thread::hardware_concurrency());
+    }
+    signal(SIGPIPE, SIG_IGN); // A client hanging up must not kill the server
+    stop_requested = false;   // Before the handlers, so an early signal is kept
+
+    // SIGINT/SIGTERM only poke the self-pipe, the loop does the cleanup
+    struct sigaction action, previous_int, previous_term;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onStopSignal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, &previous_int);
+    sigaction(SIGTERM, &action, &previous_term);
+    auto restoreSignals = [&]() {
+        sigaction(SIGINT, &previous_int, nullptr);
+        sigaction(SIGTERM, &previous_term, nullptr);
+    };
+
+    if (socket_path == "-") {
+        int status = serveStreamUntilStopped(STDIN_FILENO, STDOUT_FILENO, workers);
+        restoreSignals();
+        return status;
+    }
+
+    sockaddr_un addr;
+    if (!makeSocketAddress(socket_path, addr)) {
+        restoreSignals();
+        return 64;
+    }
+    if (!prepareSocketPath(socket_path, addr)) {
+        restoreSignals();
+        return 73;
+    }
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0 || bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listen_fd, SOMAXCONN) < 0) {
+        cerr << "Error: Could not listen on '" << socket_path << "': " << strerror(errno) << endl;
+        if (listen_fd >= 0) close(listen_fd);
+        restoreSignals();
+        return 71;
+    }
+    setNonBlocking(listen_fd);
+
+    int status = 0;
+    {
+        LexServer server(workers, read_timeout_ms);
+        if (server.openWakePipe()) {
+            server.run(listen_fd);
+        } else {
+            status = 71;
+        }
+    }
+
+    close(listen_fd);
+    unlink(socket_path.c_str());
+    restoreSignals();
+    return status;
+}
+
+// --- Client ---
+
+int runClient(const string& socket_path, const string& path, bool with_index) {
+    // The server may run in another directory, so send an absolute path
+    char resolved[PATH_MAX];
+    if (!realpath(path.c_str(), resolved)) {
+        cerr << "Error: Could not open file '" << path << "'" << endl;
+        return 66;
+    }
+
+    sockaddr_un addr;
+    if (!makeSocketAddress(socket_path, addr)) {
+        return 64;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        cerr << "Error: Could not connect to server at '" << socket_path << "': " << strerror(errno) << endl;
+        if (fd >= 0) close(fd);
+        return 69;
+    }
+
+    LexRequest request;
+    request.kind = REQUEST_FILE;
+    request.payload = resolved;
+    request.with_index = with_index;
+
+    LexResponse response;
+    bool ok = sendRequest(fd, request, response);
+    close(fd);
+    if (!ok) {
+        cerr << "Error: Lost connection to server at '" << socket_path << "'" << endl;
+        return 69;
+    }
+
+    cout << response.out << flush;
+    cerr << response.err << flush;
+    return response.exit_code;
+}
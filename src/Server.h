@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+
+// Daemon mode: one long-running process answers lex requests so build scripts
+// don't pay process startup per file.
+//
+// Wire format (the same over a Unix domain socket or stdin/stdout):
+//   request:  "<SOURCE|FILE> <payload bytes> <0|1 index>\n" <payload>
+//   response: "<exit code> <stdout bytes> <stderr bytes>\n" <stdout> <stderr>
+// SOURCE carries the C-- text itself, FILE carries a path the server opens.
+// The response holds exactly what `c-like-compiler [--index] file` would print,
+// plus the exit code it would return (0, 65 or 66). A connection may send
+// several requests back to back; responses come back in request order.
+
+enum RequestKind { REQUEST_SOURCE, REQUEST_FILE };
+
+struct LexRequest {
+    RequestKind kind = REQUEST_SOURCE;
+    std::string payload; // Source text or file path
+    bool with_index = false;
+};
+
+struct LexResponse {
+    int exit_code = 0;
+    std::string out; // Token dump (and index), as written to stdout
+    std::string err; // Diagnostics, as written to stderr
+};
+
+// Socket connections that send nothing for this long (while no response is
+// pending) are closed, so an idle or stalled client can't hold server resources.
+const int kDefaultReadTimeoutMs = 10000;
+
+// Lexes one request into `response`, reusing its string capacity. Thread-safe.
+// FILE requests are read into a per-thread buffer that keeps its capacity;
+// the Lexer itself still copies the source and builds a fresh token vector.
+void handleRequest(const LexRequest& request, LexResponse& response);
+
+// Sends one request on `fd` and waits for its response. Returns false on I/O error.
+bool sendRequest(int fd, const LexRequest& request, LexResponse& response);
+
+// Serves the request stream on `in_fd` and writes responses to `out_fd` (which
+// may be the same descriptor) until EOF, lexing up to `workers` requests at a
+// time (0 picks the hardware thread count). The descriptors are not closed.
+// Returns 0, 65 on a malformed request, or 74 if writing a response failed.
+int serveStream(int in_fd, int out_fd, unsigned workers);
+
+// Listens on the Unix domain socket `socket_path` ("-" for stdin/stdout) and
+// serves requests with `workers` threads. Refuses to replace anything at
+// `socket_path` that is not a socket, or a socket another server answers on.
+// Runs until SIGINT/SIGTERM or requestServerStop(); returns the exit code.
+int runServer(const std::string& socket_path, unsigned workers,
+              int read_timeout_ms = kDefaultReadTimeoutMs);
+
+// Makes the running runServer()/serveStream() return. Async-signal-safe.
+void requestServerStop();
+
+// Client for `c-like-compiler --client`: asks the server at `socket_path` to
+// lex `path`, copies the response to stdout/stderr and returns the exit code the
+// compiler would have. This still pays the compiler's own start-up cost; the
+// standalone build/c-like-client (LexClient.cpp) is the low-latency client.
+int runClient(const std::string& socket_path, const std::string& path, bool with_index);
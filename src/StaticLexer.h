@@ -0,0 +1,280 @@
+#pragma once
+
+#include <cstddef>
+#include <climits>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+#include <any>
+#include <string>
+#include "Token.h"
+
+// Constexpr version of the Lexer scanning logic for C-- snippets embedded as
+// string literals. LEX_STATIC always lexes at compile time, and a lexical error
+// fails the build, naming the line and column inside the snippet:
+//
+//     constexpr auto tokens = LEX_STATIC("int x; x = 10;");
+//     auto same_tokens = LEX_STATIC("int x; x = 10;"); // Also lexed at compile time
+//
+// Token lines/columns and the error rules match Lexer::tokenize(), which uses the
+// character classes and keyword table below. Lexemes are stored as offsets into
+// the (static) source literal rather than std::strings.
+
+// StaticLexError: Why scanning stopped, recorded in StaticTokenArray::error
+enum StaticLexError {
+    STATIC_LEX_OK,
+    STATIC_LEX_UNEXPECTED_CHARACTER,
+    STATIC_LEX_EXPECTED_NOT_EQUAL,   // '!' not followed by '='
+    STATIC_LEX_NUMBER_TOO_LARGE,
+    STATIC_LEX_CAPACITY_EXCEEDED
+};
+
+// StaticToken: Constexpr counterpart of Token
+struct StaticToken {
+    TokenType type = EOF_TOKEN;
+    std::size_t start = 0;  // Offset of the lexeme in the source literal
+    std::size_t length = 0; // Lexeme length (0 for EOF)
+    int literal_value = 0;  // Integer value for NUMBER tokens
+    int line = 1;
+    int column = 1;         // Column where the token starts (1-based)
+};
+
+// StaticTokenArray: Fixed-capacity token array. Every token takes at least one
+// source character, so a literal of N chars (including '\0') never needs more
+// than N slots once the EOF token is added.
+template <std::size_t Capacity>
+struct StaticTokenArray {
+    StaticToken tokens[Capacity] = {};
+    std::size_t count = 0;
+    const char* source = nullptr;
+
+    // Set by scanStatic() when it stops at a lexical error
+    StaticLexError error = STATIC_LEX_OK;
+    int error_line = 0;
+    int error_column = 0;
+    char error_char = '\0';
+    std::size_t error_start = 0;  // Offending lexeme, e.g. the whole too-large number
+    std::size_t error_length = 0;
+
+    constexpr std::size_t size() const { return count; }
+    constexpr const StaticToken& operator[](std::size_t i) const { return tokens[i]; }
+    constexpr const StaticToken* begin() const { return tokens; }
+    constexpr const StaticToken* end() const { return tokens + count; }
+
+    constexpr std::string_view value(const StaticToken& token) const {
+        return std::string_view(source + token.start, token.length);
+    }
+
+    // Converts to the runtime representation, e.g. to feed code expecting Lexer output
+    std::vector<Token> toTokens() const {
+        std::vector<Token> out;
+        out.reserve(count);
+        for (const auto& token : *this) {
+            std::any literal = token.type == NUMBER ? std::any(token.literal_value) : std::any();
+            out.emplace_back(token.type, std::string(value(token)), literal, token.line, token.column);
+        }
+        return out;
+    }
+
+    // The first error exactly as Lexer::tokenize() reports it, or "" if there is none
+    std::string errorMessage() const {
+        std::string message;
+        switch (error) {
+            case STATIC_LEX_OK: return "";
+            case STATIC_LEX_UNEXPECTED_CHARACTER: message = "Unexpected character '" + std::string(1, error_char) + "'"; break;
+            case STATIC_LEX_EXPECTED_NOT_EQUAL: message = "Unexpected character '!' (expected '!=')"; break;
+            case STATIC_LEX_NUMBER_TOO_LARGE:
+                message = "Number literal '" + std::string(source + error_start, error_length) + "' is too large.";
+                break;
+            case STATIC_LEX_CAPACITY_EXCEEDED: message = "Token capacity exceeded"; break;
+        }
+        return "[Lexer Error] line " + std::to_string(error_line) + ", col " +
+               std::to_string(error_column) + ": " + message;
+    }
+};
+
+// Character classes (ASCII, like isdigit/isalpha/isalnum in the "C" locale).
+// Lexer.cpp uses these and lookupStaticKeyword() too, so both lexers agree.
+constexpr bool isStaticDigit(char c) { return c >= '0' && c <= '9'; }
+constexpr bool isStaticAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+constexpr bool isStaticIdentChar(char c) { return isStaticAlpha(c) || isStaticDigit(c) || c == '_'; }
+
+// Keyword lookup; returns IDENTIFIER when the text is not a keyword
+constexpr TokenType lookupStaticKeyword(std::string_view text) {
+    struct Entry { std::string_view name; TokenType type; };
+    constexpr Entry table[] = {
+        {"int", KEYWORD_INT},       {"void", KEYWORD_VOID},
+        {"if", KEYWORD_IF},         {"else", KEYWORD_ELSE},
+        {"while", KEYWORD_WHILE},   {"return", KEYWORD_RETURN},
+        {"input", KEYWORD_INPUT},   {"output", KEYWORD_OUTPUT},
+    };
+    for (const auto& entry : table) {
+        if (entry.name == text) return entry.type;
+    }
+    return IDENTIFIER;
+}
+
+// Tokenizes the first `length` chars of `text` into `out`. Stops at the first
+// lexical error, recording it in out.error/error_line/error_column, and returns
+// false. Usable both at compile time and at runtime.
+template <std::size_t Capacity>
+constexpr bool scanStatic(StaticTokenArray<Capacity>& out, const char* text, std::size_t length) {
+    out.source = text;
+    out.count = 0;
+    out.error = STATIC_LEX_OK;
+    std::size_t i = 0;
+    int line = 1;
+    int column = 0; // 0-based, like Lexer::column
+
+    auto fail = [&](StaticLexError error, int error_column, std::size_t error_start) {
+        out.error = error;
+        out.error_line = line;
+        out.error_column = error_column;
+        out.error_char = error_start < length ? text[error_start] : '\0';
+        out.error_start = error_start;
+        out.error_length = i - error_start;
+        return false;
+    };
+
+    auto push = [&](TokenType type, std::size_t start, int start_column, int literal) {
+        if (out.count >= Capacity) return fail(STATIC_LEX_CAPACITY_EXCEEDED, start_column, start);
+        StaticToken& token = out.tokens[out.count++];
+        token.type = type;
+        token.start = start;
+        token.length = i - start;
+        token.literal_value = literal;
+        token.line = line;
+        token.column = start_column;
+        return true;
+    };
+
+    while (true) {
+        // Skip whitespace and // comments
+        while (i < length) {
+            char c = text[i];
+            if (c == ' ' || c == '\r' || c == '\t') {
+                i++;
+                column++;
+            } else if (c == '\n') {
+                i++;
+                line++;
+                column = 0;
+            } else if (c == '/' && i + 1 < length && text[i + 1] == '/') {
+                while (i < length && text[i] != '\n') {
+                    i++;
+                    column++;
+                }
+            } else {
+                break;
+            }
+        }
+        if (i >= length) break;
+
+        std::size_t start = i;
+        int start_column = column + 1;
+        char c = text[i++];
+        column++;
+
+        auto match = [&](char expected) {
+            if (i < length && text[i] == expected) {
+                i++;
+                column++;
+                return true;
+            }
+            return false;
+        };
+
+        TokenType type = EOF_TOKEN;
+        int literal = 0;
+        switch (c) {
+            case '(': type = DELIM_LPAREN; break;
+            case ')': type = DELIM_RPAREN; break;
+            case '{': type = DELIM_LBRACE; break;
+            case '}': type = DELIM_RBRACE; break;
+            case '[': type = DELIM_LBRACKET; break;
+            case ']': type = DELIM_RBRACKET; break;
+            case ';': type = DELIM_SEMICOLON; break;
+            case ',': type = DELIM_COMMA; break;
+            case '+': type = OP_PLUS; break;
+            case '-': type = OP_MINUS; break;
+            case '*': type = OP_MULTIPLY; break;
+            case '/': type = OP_DIVIDE; break;
+
+            case '!':
+                if (!match('=')) return fail(STATIC_LEX_EXPECTED_NOT_EQUAL, start_column, start);
+                type = OP_NOT_EQUAL;
+                break;
+            case '=': type = match('=') ? OP_EQUAL : OP_ASSIGN; break;
+            case '<': type = match('=') ? OP_LESS_EQUAL : OP_LESS; break;
+            case '>': type = match('=') ? OP_GREATER_EQUAL : OP_GREATER; break;
+
+            default:
+                if (isStaticDigit(c)) {
+                    long long value = c - '0';
+                    bool too_large = false;
+                    while (i < length && isStaticDigit(text[i])) {
+                        value = value * 10 + (text[i] - '0');
+                        if (value > INT_MAX) {
+                            too_large = true;
+                            value = INT_MAX; // Keep scanning so the error shows the whole literal
+                        }
+                        i++;
+                        column++;
+                    }
+                    if (too_large) return fail(STATIC_LEX_NUMBER_TOO_LARGE, start_column, start);
+                    type = NUMBER;
+                    literal = static_cast<int>(value);
+                } else if (isStaticAlpha(c) || c == '_') {
+                    while (i < length && isStaticIdentChar(text[i])) {
+                        i++;
+                        column++;
+                    }
+                    type = lookupStaticKeyword(std::string_view(text + start, i - start));
+                } else {
+                    return fail(STATIC_LEX_UNEXPECTED_CHARACTER, start_column, start);
+                }
+                break;
+        }
+        if (!push(type, start, start_column, literal)) return false;
+    }
+
+    return push(EOF_TOKEN, i, column + 1, 0);
+}
+
+// Runtime entry point: like scanStatic(), but throws std::invalid_argument
+// carrying errorMessage() on a lexical error.
+template <std::size_t Capacity>
+void lexStaticInto(StaticTokenArray<Capacity>& out, const char* text, std::size_t length) {
+    if (!scanStatic(out, text, length)) {
+        throw std::invalid_argument(out.errorMessage());
+    }
+}
+
+// Scans a literal with capacity derived from its length. Errors are only
+// recorded, so prefer LEX_STATIC, which turns them into compile errors.
+template <std::size_t N>
+constexpr StaticTokenArray<N> lexStaticUnchecked(const char (&source)[N]) {
+    StaticTokenArray<N> out;
+    scanStatic(out, source, N - 1);
+    return out;
+}
+
+// Fails to compile when Error is set. The compiler prints the template
+// arguments, which give the error kind and its line and column in the snippet
+// (GCC: "[with StaticLexError Error = STATIC_LEX_UNEXPECTED_CHARACTER; int Line = 1;
+// int Column = 5]", Clang: "checkStaticLex<STATIC_LEX_UNEXPECTED_CHARACTER, 1, 5>").
+template <StaticLexError Error, int Line, int Column>
+constexpr void checkStaticLex() {
+    static_assert(Error == STATIC_LEX_OK,
+                  "lexical error in embedded C-- snippet (kind, line and column are the template arguments)");
+}
+
+// Front end: the constexpr local forces compile-time lexing wherever the macro
+// is used, and checkStaticLex<> rejects snippets with lexical errors.
+#define LEX_STATIC(literal)                                                              \
+    ([]() {                                                                              \
+        constexpr auto lex_static_tokens_ = lexStaticUnchecked(literal);                 \
+        checkStaticLex<lex_static_tokens_.error, lex_static_tokens_.error_line,          \
+                       lex_static_tokens_.error_column>();                               \
+        return lex_static_tokens_;                                                       \
+    }())
@@ -0,0 +1,192 @@
+#include "TokenIndex.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+TokenIndex::TokenIndex() {
+    type_counts.fill(0);
+}
+
+void TokenIndex::clear() {
+    postings.clear();
+    type_counts.fill(0);
+}
+
+void TokenIndex::appendIndex(PostingList& list, size_t token_index) {
+    size_t delta = token_index - list.last_index;
+    while (delta >= 0x80) {
+        list.deltas.push_back(static_cast<uint8_t>(delta | 0x80));
+        delta >>= 7;
+    }
+    list.deltas.push_back(static_cast<uint8_t>(delta));
+    list.last_index = token_index;
+    list.count++;
+}
+
+void TokenIndex::add(TokenType type, const string& value, size_t token_index) {
+    type_counts[type]++;
+    if (type == IDENTIFIER) {
+        appendIndex(postings[value], token_index);
+    }
+}
+
+vector<size_t> TokenIndex::occurrences(const string& identifier) const {
+    vector<size_t> result;
+    auto it = postings.find(identifier);
+    if (it == postings.end()) {
+        return result;
+    }
+
+    const PostingList& list = it->second;
+    result.reserve(list.count);
+    size_t index = 0;
+    size_t delta = 0;
+    int shift = 0;
+    for (uint8_t byte : list.deltas) {
+        delta |= static_cast<size_t>(byte & 0x7f) << shift;
+        if (byte & 0x80) {
+            shift += 7;
+            continue;
+        }
+        index += delta;
+        result.push_back(index);
+        delta = 0;
+        shift = 0;
+    }
+    return result;
+}
+
+size_t TokenIndex::occurrenceCount(const string& identifier) const {
+    auto it = postings.find(identifier);
+    return it == postings.end() ? 0 : it->second.count;
+}
+
+size_t TokenIndex::count(TokenType type) const {
+    return type_counts[type];
+}
+
+// Format:
+//   index <distinct identifiers>
+//   count <TokenType name> <n>              (one line per non-zero type)
+//   ident <name> <n> <gap> <gap> ...        (gaps between token indices)
+//   end
+void TokenIndex::write(ostream& out) const {
+    out << "index " << postings.size() << "\n";
+    for (size_t t = 0; t < type_counts.size(); t++) {
+        if (type_counts[t] != 0) {
+            out << "count " << tokenTypeToString(static_cast<TokenType>(t)) << " " << type_counts[t] << "\n";
+        }
+    }
+
+    vector<const string*> names;
+    names.reserve(postings.size());
+    for (const auto& entry : postings) {
+        names.push_back(&entry.first);
+    }
+    sort(names.begin(), names.end(), [](const string* a, const string* b) { return *a < *b; });
+
+    for (const string* name : names) {
+        out << "ident " << *name << " " << postings.at(*name).count;
+        size_t previous = 0;
+        for (size_t index : occurrences(*name)) {
+            out << " " << (index - previous);
+            previous = index;
+        }
+        out << "\n";
+    }
+    out << "end" << endl;
+}
+
+// Parses one unsigned decimal field as write() prints it; rejects signs,
+// leading zeros, other characters and overflow
+static bool readNumberField(istream& fields, size_t& value) {
+    string text;
+    if (!(fields >> text) || text.size() > 19 || (text.size() > 1 && text[0] == '0')) return false;
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + static_cast<size_t>(c - '0');
+    }
+    return true;
+}
+
+// True if nothing but whitespace is left on the line
+static bool atLineEnd(istream& fields) {
+    fields >> ws;
+    return fields.eof();
+}
+
+// Strict inverse of write(): sections in write() order, count lines by
+// increasing type, ident lines by increasing name (so no duplicates), each
+// occurrence after the first at a positive gap, no extra fields, and an
+// IDENTIFIER count equal to the number of occurrences.
+bool TokenIndex::read(istream& in, TokenIndex& index) {
+    index.clear();
+
+    string line;
+    size_t expected_identifiers = 0;
+    if (!getline(in, line)) return false;
+    {
+        istringstream header(line);
+        string tag;
+        if (!(header >> tag) || tag != "index") return false;
+        if (!readNumberField(header, expected_identifiers) || !atLineEnd(header)) return false;
+    }
+
+    size_t next_type = 0;        // Count lines must name types in increasing order
+    const string* previous_name = nullptr;
+    size_t total_occurrences = 0;
+    while (getline(in, line)) {
+        istringstream fields(line);
+        string tag;
+        fields >> tag;
+
+        if (tag == "end") {
+            if (!atLineEnd(fields)) return false;
+            return index.postings.size() == expected_identifiers &&
+                   index.type_counts[IDENTIFIER] == total_occurrences;
+        } else if (tag == "count") {
+            if (previous_name) return false; // Counts come before identifiers
+            string type_name;
+            size_t n = 0;
+            if (!(fields >> type_name) || !readNumberField(fields, n) || n == 0 || !atLineEnd(fields)) return false;
+            bool found = false;
+            for (size_t t = next_type; t < index.type_counts.size(); t++) {
+                if (tokenTypeToString(static_cast<TokenType>(t)) == type_name) {
+                    index.type_counts[t] = n;
+                    next_type = t + 1;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) return false;
+        } else if (tag == "ident") {
+            string name;
+            size_t n = 0;
+            if (!(fields >> name) || !readNumberField(fields, n) || n == 0) return false;
+            if (previous_name && !(*previous_name < name)) return false;
+            auto inserted = index.postings.emplace(name, PostingList());
+            previous_name = &inserted.first->first;
+            PostingList& list = inserted.first->second;
+            size_t token_index = 0;
+            for (size_t i = 0; i < n; i++) {
+                size_t gap = 0;
+                if (!readNumberField(fields, gap)) return false;
+                if (i > 0 && gap == 0) return false;             // Indices strictly increase
+                if (gap > SIZE_MAX - token_index) return false;  // Overflow
+                token_index += gap;
+                appendIndex(list, token_index);
+            }
+            if (!atLineEnd(fields)) return false;
+            total_occurrences += n;
+        } else {
+            return false;
+        }
+    }
+    return false; // Missing "end"
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <iosfwd>
+#include <cstddef>
+#include <cstdint>
+#include "Token.h"
+
+// TokenIndex: Optional side table filled by Lexer::tokenize(). It maps every
+// distinct identifier to the indices of its tokens in the token vector and keeps
+// a count per TokenType, so "where is x used" is answered in O(occurrences)
+// instead of a scan over every Token::value.
+class TokenIndex {
+public:
+    TokenIndex();
+
+    void clear();
+
+    // Records token number `token_index` (its position in the token vector).
+    // Indices must be added in increasing order.
+    void add(TokenType type, const std::string& value, size_t token_index);
+
+    // Token indices of every occurrence of `identifier`, in source order
+    std::vector<size_t> occurrences(const std::string& identifier) const;
+    size_t occurrenceCount(const std::string& identifier) const;
+
+    size_t count(TokenType type) const;
+    size_t distinctIdentifiers() const { return postings.size(); }
+
+    // Text form, written after the token dump by `--index`. Identifiers are
+    // sorted so the output is stable; read() accepts exactly what write() emits
+    // and returns false (leaving `index` unspecified) on anything else.
+    void write(std::ostream& out) const;
+    static bool read(std::istream& in, TokenIndex& index);
+
+private:
+    // Posting list: gaps between successive token indices, LEB128 varint encoded.
+    // Identifiers are rarely more than a few hundred tokens apart, so most gaps
+    // take one or two bytes.
+    struct PostingList {
+        std::vector<uint8_t> deltas;
+        size_t last_index = 0;
+        size_t count = 0;
+    };
+
+    std::unordered_map<std::string, PostingList> postings;
+    std::array<size_t, EOF_TOKEN + 1> type_counts;
+
+    static void appendIndex(PostingList& list, size_t token_index);
+};
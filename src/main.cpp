@@ -1,25 +1,112 @@
 #include "Lexer.h"
 #include "Token.h"
+#include "ParallelDriver.h"
+#include "TokenIndex.h"
+#include "Server.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <string>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
 
 using namespace std;
 
 // Forward declaration for the error reporting function
 extern bool had_lexer_error; // Declare the error flag from Lexer.cpp
 
-void runFile(const string& path);
+// Set when the parallel driver reports a structural error
+bool had_structure_error = false;
+
+// Set by --index: write the identifier occurrence index after the token dump
+static bool print_index = false;
+
+void runFile(const string& path, int jobs);
 void runPrompt();
 void run(const string& source);
+void runParallel(const string& source, unsigned jobs);
+
+static void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [--jobs N] [--index] [script_file]" << endl;
+    cerr << "       " << program << " --serve SOCKET|- [--workers N]" << endl;
+    cerr << "       " << program << " --client SOCKET [--index] script_file" << endl;
+}
+
+// Parses a non-negative count argument; reports and returns false if invalid
+static bool parseCount(const char* text, const char* what, int& value) {
+    char* end = nullptr;
+    errno = 0;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < 0 || parsed > INT_MAX) {
+        cerr << "Error: Invalid " << what << " '" << text << "'" << endl;
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
 
 int main(int argc, char* argv[]) {
-    if (argc > 2) {
-        cerr << "Usage: " << argv[0] << " [script_file]" << endl;
-        return 64; 
-    } else if (argc == 2) {
-        runFile(argv[1]);
+    // jobs < 0: sequential token dump; jobs >= 0: function-level parallel driver
+    // (0 picks the hardware thread count).
+    int jobs = -1;
+    int workers = 0;
+    string path;
+    string serve_socket;  // --serve: run as a daemon on this socket ("-" for stdio)
+    string client_socket; // --client: forward the file to the daemon on this socket
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool takes_value = arg == "--jobs" || arg == "-j" || arg == "--workers" ||
+                           arg == "--serve" || arg == "--client";
+        if (takes_value && i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 64;
+        }
+
+        if (arg == "--jobs" || arg == "-j") {
+            if (!parseCount(argv[++i], "job count", jobs)) return 64;
+            if (static_cast<unsigned>(jobs) > kMaxParallelJobs) {
+                cerr << "Warning: job count " << jobs << " capped at " << kMaxParallelJobs << endl;
+            }
+        } else if (arg == "--workers") {
+            if (!parseCount(argv[++i], "worker count", workers)) return 64;
+        } else if (arg == "--serve") {
+            serve_socket = argv[++i];
+        } else if (arg == "--client") {
+            client_socket = argv[++i];
+        } else if (arg == "--index") {
+            print_index = true;
+        } else if (path.empty() && (arg.empty() || arg[0] != '-')) {
+            path = arg;
+        } else {
+            printUsage(argv[0]);
+            return 64;
+        }
+    }
+
+    if (!serve_socket.empty()) {
+        if (!path.empty() || !client_socket.empty() || jobs >= 0 || print_index) {
+            printUsage(argv[0]); // Options like --index are chosen per request
+            return 64;
+        }
+        return runServer(serve_socket, static_cast<unsigned>(workers));
+    }
+
+    if (!client_socket.empty()) {
+        if (path.empty() || jobs >= 0) {
+            printUsage(argv[0]);
+            return 64;
+        }
+        return runClient(client_socket, path, print_index);
+    }
+
+    if (!path.empty()) {
+        runFile(path, jobs);
+    } else if (jobs >= 0) {
+        printUsage(argv[0]); // The parallel driver only works on whole files
+        return 64;
     } else {
         runPrompt();
     }
@@ -27,21 +114,25 @@ int main(int argc, char* argv[]) {
     return 0;
 }
 
-void runFile(const string& path) {
+void runFile(const string& path, int jobs) {
     ifstream file(path);
     if (!file.is_open()) {
         cerr << "Error: Could not open file '" << path << "'" << endl;
-        exit(66); 
+        exit(66);
     }
 
     stringstream buffer;
-    buffer << file.rdbuf(); 
+    buffer << file.rdbuf();
     string source = buffer.str();
 
-    run(source);
+    if (jobs >= 0) {
+        runParallel(source, static_cast<unsigned>(jobs));
+    } else {
+        run(source);
+    }
 
-    if (had_lexer_error) { 
-        exit(65); 
+    if (had_lexer_error || had_structure_error) {
+        exit(65);
     }
 }
 
@@ -49,20 +140,48 @@ void runPrompt() {
     string line;
     while (true) {
         cout << "> ";
-        if (!getline(cin, line)) { /
+        if (!getline(cin, line)) { // Stop on EOF (Ctrl+D)
             break;
         }
         run(line);
-        had_lexer_error = false; 
+        had_lexer_error = false;
     }
 }
 
 void run(const string& source) {
-    Lexer lexer(source);
+    TokenIndex index;
+    Lexer lexer(source, print_index ? &index : nullptr);
     vector<Token> tokens = lexer.tokenize();
 
     // Output tokens
     for (const auto& token : tokens) {
         cout << token.toString() << endl;
     }
-}
\ No newline at end of file
+    if (print_index) {
+        index.write(cout);
+    }
+}
+
+// Lexes the whole file once, then checks each top-level function on a worker
+// thread. Results are merged in source order, so output matches run() and does
+// not depend on the thread count.
+void runParallel(const string& source, unsigned jobs) {
+    TokenIndex index;
+    Lexer lexer(source, print_index ? &index : nullptr);
+    vector<Token> tokens = lexer.tokenize();
+
+    vector<TopLevelUnit> units = splitTopLevelUnits(tokens);
+    vector<UnitResult> results = checkUnitsParallel(tokens, units, jobs);
+
+    for (const auto& result : results) {
+        cout << result.output;
+        for (const auto& diagnostic : result.diagnostics) {
+            cerr << diagnostic << endl;
+            had_structure_error = true;
+        }
+    }
+    cout << tokens.back().toString() << endl; // EOF token
+    if (print_index) {
+        index.write(cout);
+    }
+}
@@ -0,0 +1,198 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <functional>
+#include <thread>
+#include <algorithm>
+
+#include "../src/Lexer.h"
+#include "../src/Token.h"
+#include "../src/ParallelDriver.h"
+
+using namespace std;
+
+extern bool had_lexer_error; // From Lexer.cpp
+
+// Helper to run a string through the lexer and return tokens
+vector<Token> tokenize_string(const string& source) {
+    had_lexer_error = false; // Reset global error flag before each test
+    Lexer lexer(source);
+    return lexer.tokenize();
+}
+
+// Joins the per-unit outputs in source order, as the driver does
+string merged_output(const vector<UnitResult>& results) {
+    string out;
+    for (const auto& result : results) out += result.output;
+    return out;
+}
+
+size_t diagnostic_count(const vector<UnitResult>& results) {
+    size_t count = 0;
+    for (const auto& result : results) count += result.diagnostics.size();
+    return count;
+}
+
+bool assert_unit(const TopLevelUnit& actual, size_t expected_begin, size_t expected_end,
+                 bool expected_function, const string& step_name) {
+    cout << "  Testing " << step_name << "... ";
+    if (actual.begin == expected_begin && actual.end == expected_end &&
+        actual.is_function == expected_function) {
+        cout << "PASS" << endl;
+        return true;
+    }
+    cerr << "FAIL: " << step_name << endl;
+    cerr << "  Expected: [" << expected_begin << ", " << expected_end << ") function=" << expected_function << endl;
+    cerr << "  Actual:   [" << actual.begin << ", " << actual.end << ") function=" << actual.is_function << endl;
+    return false;
+}
+
+void run_parallel_driver_tests() {
+    cout << "--- Running Parallel Driver Tests ---" << endl;
+    bool all_tests_passed = true;
+
+    auto run_test_block = [&](const string& name, const function<bool()>& test_func) {
+        cout << "\nTest Block: " << name << endl;
+        bool block_passed = test_func();
+        if (block_passed) {
+            cout << "SUCCESS: All tests in '" << name << "' block passed." << endl;
+        } else {
+            cout << "FAILURE: Some tests in '" << name << "' block failed." << endl;
+            all_tests_passed = false;
+        }
+        return block_passed;
+    };
+
+    // Test 1: Unit boundaries for globals and nested function bodies
+    run_test_block("Top-Level Split", [&]() {
+        // Tokens: int g ; | void f ( ) { if ( g ) { g = 1 ; } } | int h ( void ) { return g ; } | EOF
+        string source = "int g;\nvoid f() { if (g) { g = 1; } }\nint h(void) { return g; }";
+        vector<Token> tokens = tokenize_string(source);
+        if (had_lexer_error) { cerr << "Fail: Lexical errors detected." << endl; return false; }
+
+        vector<TopLevelUnit> units = splitTopLevelUnits(tokens);
+        if (units.size() != 3) {
+            cerr << "Fail: Incorrect unit count. Expected 3, got " << units.size() << endl;
+            return false;
+        }
+
+        bool ok = true;
+        ok &= assert_unit(units[0], 0, 3, false, "global declaration");
+        ok &= assert_unit(units[1], 3, 19, true, "function with nested block");
+        ok &= assert_unit(units[2], 19, 29, true, "second function");
+        return ok;
+    });
+
+    // Test 2: Output is identical to the sequential dump for every thread count
+    run_test_block("Deterministic Merge", [&]() {
+        string source;
+        for (int i = 0; i < 200; i++) {
+            source += "int f" + to_string(i) + "(int a) {\n    while (a > 0) { a = a - 1; }\n    return a;\n}\n";
+        }
+        vector<Token> tokens = tokenize_string(source);
+        if (had_lexer_error) { cerr << "Fail: Lexical errors detected." << endl; return false; }
+
+        string expected;
+        for (size_t i = 0; i + 1 < tokens.size(); i++) {
+            expected += tokens[i].toString() + "\n";
+        }
+
+        vector<TopLevelUnit> units = splitTopLevelUnits(tokens);
+        if (units.size() != 200) {
+            cerr << "Fail: Incorrect unit count. Expected 200, got " << units.size() << endl;
+            return false;
+        }
+
+        bool ok = true;
+        for (unsigned jobs : {1u, 2u, 3u, 8u, 0u}) {
+            cout << "  Testing jobs=" << jobs << "... ";
+            vector<UnitResult> results = checkUnitsParallel(tokens, units, jobs);
+            if (merged_output(results) == expected && diagnostic_count(results) == 0) {
+                cout << "PASS" << endl;
+            } else {
+                cerr << "FAIL: output differs from sequential dump for jobs=" << jobs << endl;
+                ok = false;
+            }
+        }
+        return ok;
+    });
+
+    // Test 3: Explicit job counts are honoured, not replaced by the core count
+    run_test_block("Job Count", [&]() {
+        bool ok = true;
+        const struct { unsigned jobs; size_t units; unsigned expected; const char* name; } cases[] = {
+            {8, 200, 8, "jobs=8 starts 8 threads"},
+            {3, 200, 3, "jobs=3 starts 3 threads"},
+            {8, 2, 2, "capped at the unit count"},
+            {100000, 100000, kMaxParallelJobs, "capped at kMaxParallelJobs"},
+            {1, 0, 1, "no units still runs on the caller"},
+        };
+        for (const auto& test_case : cases) {
+            cout << "  Testing " << test_case.name << "... ";
+            unsigned actual = effectiveJobs(test_case.jobs, test_case.units);
+            if (actual == test_case.expected) {
+                cout << "PASS" << endl;
+            } else {
+                cerr << "FAIL: expected " << test_case.expected << ", got " << actual << endl;
+                ok = false;
+            }
+        }
+        cout << "  Testing jobs=0 uses the hardware thread count... ";
+        unsigned hardware = max(1u, thread::hardware_concurrency());
+        if (effectiveJobs(0, 1000) == min(hardware, kMaxParallelJobs)) {
+            cout << "PASS" << endl;
+        } else {
+            cerr << "FAIL" << endl;
+            ok = false;
+        }
+        return ok;
+    });
+
+    // Test 4: Structural errors are reported against the right unit
+    run_test_block("Structural Errors", [&]() {
+        string source = "int ok() { return 1; }\nint bad( { return (1; }\n5 x() { }";
+        vector<Token> tokens = tokenize_string(source);
+        if (had_lexer_error) { cerr << "Fail: Lexical errors detected." << endl; return false; }
+
+        vector<TopLevelUnit> units = splitTopLevelUnits(tokens);
+        vector<UnitResult> results = checkUnitsParallel(tokens, units, 2);
+        if (results.size() != 3) {
+            cerr << "Fail: Incorrect unit count. Expected 3, got " << results.size() << endl;
+            return false;
+        }
+
+        bool ok = true;
+        cout << "  Testing well-formed function has no diagnostics... ";
+        if (results[0].diagnostics.empty()) { cout << "PASS" << endl; } else { cerr << "FAIL: " << results[0].diagnostics[0] << endl; ok = false; }
+
+        cout << "  Testing unbalanced function is reported... ";
+        if (!results[1].diagnostics.empty() && results[1].diagnostics[0].find("line 2") != string::npos) {
+            cout << "PASS" << endl;
+        } else {
+            cerr << "FAIL: expected a line 2 diagnostic" << endl;
+            ok = false;
+        }
+
+        cout << "  Testing missing return type is reported... ";
+        if (!results[2].diagnostics.empty() && results[2].diagnostics[0].find("return type") != string::npos) {
+            cout << "PASS" << endl;
+        } else {
+            cerr << "FAIL: expected a return type diagnostic" << endl;
+            ok = false;
+        }
+        return ok;
+    });
+
+    if (all_tests_passed) {
+        cout << "\n=== ALL PARALLEL DRIVER TESTS PASSED ===\n" << endl;
+    } else {
+        cerr << "\n!!! SOME PARALLEL DRIVER TESTS FAILED !!!\n" << endl;
+        exit(1);
+    }
+}
+
+
+int main() {
+    run_parallel_driver_tests();
+    return 0;
+}
@@ -0,0 +1,397 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <future>
+#include <functional>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../src/Lexer.h"
+#include "../src/Token.h"
+#include "../src/Server.h"
+
+using namespace std;
+
+extern bool had_lexer_error; // From Lexer.cpp
+
+// Expected stdout of `c-like-compiler file` for `source`
+string expected_dump(const string& source) {
+    vector<string> errors; // Keep the reference run quiet
+    Lexer lexer(source);
+    lexer.setErrorSink(&errors);
+    string out;
+    for (const auto& token : lexer.tokenize()) {
+        out += token.toString() + "\n";
+    }
+    return out;
+}
+
+string read_file(const string& path) {
+    ifstream file(path);
+    stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+bool write_all(int fd, const string& data) {
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t n = write(fd, data.data() + done, data.size() - done);
+        if (n <= 0) return false;
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+string read_until_eof(int fd) {
+    string data;
+    char chunk[65536];
+    ssize_t n;
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+        data.append(chunk, static_cast<size_t>(n));
+    }
+    return data;
+}
+
+string request_frame(const string& source) {
+    return "SOURCE " + to_string(source.size()) + " 0\n" + source;
+}
+
+// Splits a stream of response frames; returns false if it is malformed
+bool parse_responses(const string& data, vector<LexResponse>& responses) {
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t newline = data.find('\n', pos);
+        if (newline == string::npos) return false;
+        LexResponse response;
+        size_t out_length = 0, err_length = 0;
+        istringstream header(data.substr(pos, newline - pos));
+        if (!(header >> response.exit_code >> out_length >> err_length)) return false;
+        pos = newline + 1;
+        if (data.size() - pos < out_length + err_length) return false;
+        response.out = data.substr(pos, out_length);
+        response.err = data.substr(pos + out_length, err_length);
+        pos += out_length + err_length;
+        responses.push_back(response);
+    }
+    return true;
+}
+
+int connect_to(const string& path) {
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) return fd;
+    if (fd >= 0) close(fd);
+    return -1;
+}
+
+// Runs a shell command; returns its exit code and stdout in `output`
+int run_command(const string& command, string& output) {
+    output.clear();
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe) return -1;
+    char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), pipe)) > 0) {
+        output.append(chunk, n);
+    }
+    int status = pclose(pipe);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// Connects to a server that is starting up; returns -1 if it never answers
+int wait_for_server(const string& path) {
+    for (int i = 0; i < 3000; i++) {
+        int fd = connect_to(path);
+        if (fd >= 0) return fd;
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    return -1;
+}
+
+bool path_exists(const string& path) {
+    struct stat info;
+    return lstat(path.c_str(), &info) == 0;
+}
+
+bool assert_response(const LexResponse& actual, int expected_exit, const string& expected_out,
+                     bool expect_err, const string& test_case_name) {
+    cout << "  Testing " << test_case_name << "... ";
+    bool ok = actual.exit_code == expected_exit && actual.out == expected_out &&
+              actual.err.empty() != expect_err;
+    if (ok) {
+        cout << "PASS" << endl;
+        return true;
+    }
+    cerr << "FAIL: " << test_case_name << endl;
+    cerr << "  Expected exit " << expected_exit << ", got " << actual.exit_code << endl;
+    cerr << "  stderr: " << actual.err << endl;
+    return false;
+}
+
+bool check(bool condition, const string& test_case_name) {
+    cout << "  Testing " << test_case_name << "... ";
+    if (condition) {
+        cout << "PASS" << endl;
+    } else {
+        cerr << "FAIL: " << test_case_name << endl;
+    }
+    return condition;
+}
+
+void run_server_tests() {
+    cout << "--- Running Server Tests ---" << endl;
+    bool all_tests_passed = true;
+
+    auto run_test_block = [&](const string& name, const function<bool()>& test_func) {
+        cout << "\nTest Block: " << name << endl;
+        bool block_passed = test_func();
+        if (block_passed) {
+            cout << "SUCCESS: All tests in '" << name << "' block passed." << endl;
+        } else {
+            cout << "FAILURE: Some tests in '" << name << "' block failed." << endl;
+            all_tests_passed = false;
+        }
+        return block_passed;
+    };
+
+    // Test 1: Several requests over one connection, served by serveStream()
+    run_test_block("Request/Response Framing", [&]() {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) { cerr << "Fail: socketpair" << endl; return false; }
+        int served_status = -1;
+        thread server([&]() { served_status = serveStream(fds[0], fds[0], 2); });
+
+        bool ok = true;
+        LexResponse response;
+
+        LexRequest source_request;
+        source_request.payload = "int x;\nx = 10; // comment\n";
+        ok &= sendRequest(fds[1], source_request, response);
+        ok &= assert_response(response, 0, expected_dump(source_request.payload), false, "SOURCE request");
+
+        LexRequest bad_request;
+        bad_request.payload = "int @x;";
+        ok &= sendRequest(fds[1], bad_request, response);
+        ok &= assert_response(response, 65, expected_dump(bad_request.payload), true, "lexical error gives exit 65");
+
+        LexRequest file_request;
+        file_request.kind = REQUEST_FILE;
+        file_request.payload = "tests/sample_programs/hello.c--";
+        ok &= sendRequest(fds[1], file_request, response);
+        ok &= assert_response(response, 0, expected_dump(read_file(file_request.payload)), false, "FILE request");
+
+        file_request.payload = "tests/sample_programs/does_not_exist.c--";
+        ok &= sendRequest(fds[1], file_request, response);
+        ok &= assert_response(response, 66, "", true, "missing file gives exit 66");
+
+        file_request.payload = "tests";
+        ok &= sendRequest(fds[1], file_request, response);
+        ok &= assert_response(response, 0, expected_dump(""), false, "directory lexes as empty, like main()");
+
+        LexRequest index_request;
+        index_request.payload = "a = a;";
+        index_request.with_index = true;
+        ok &= sendRequest(fds[1], index_request, response);
+        ok &= check(response.out.find("ident a 2 0 2\n") != string::npos, "index in response");
+
+        shutdown(fds[1], SHUT_WR); // EOF ends serveStream()
+        server.join();
+        close(fds[0]);
+        close(fds[1]);
+        ok &= check(served_status == 0, "clean shutdown on EOF");
+        ok &= check(!had_lexer_error, "global error flag untouched");
+        return ok;
+    });
+
+    // Test 2: Concurrent handleRequest() calls give the sequential answers
+    run_test_block("Concurrent Requests", [&]() {
+        const int thread_count = 4;
+        const int requests_per_thread = 50;
+        vector<vector<string>> sources(thread_count), expected(thread_count);
+        for (int t = 0; t < thread_count; t++) {
+            for (int i = 0; i < requests_per_thread; i++) {
+                string source = "int f" + to_string(t) + "_" + to_string(i) + "(int a) { return a " +
+                                (i % 2 ? "# 1; }" : "+ 1; }");
+                sources[t].push_back(source);
+                expected[t].push_back(expected_dump(source));
+            }
+        }
+
+        vector<int> mismatches(thread_count, 0);
+        vector<thread> clients;
+        for (int t = 0; t < thread_count; t++) {
+            clients.emplace_back([&, t]() {
+                LexResponse response;
+                for (int i = 0; i < requests_per_thread; i++) {
+                    LexRequest request;
+                    request.payload = sources[t][i];
+                    handleRequest(request, response);
+                    int expected_exit = i % 2 ? 65 : 0;
+                    if (response.exit_code != expected_exit || response.out != expected[t][i]) mismatches[t]++;
+                }
+            });
+        }
+        for (auto& client : clients) client.join();
+
+        bool ok = true;
+        for (int count : mismatches) ok &= count == 0;
+        ok = check(ok, "full output under concurrency");
+        ok &= check(!had_lexer_error, "global error flag untouched");
+        return ok;
+    });
+
+    // Test 3: Pipelined stdio-style requests come back in request order, even
+    // when later (small) requests finish before earlier (large) ones.
+    run_test_block("Stream Ordering", [&]() {
+        string large;
+        for (int i = 0; i < 2000; i++) large += "int f" + to_string(i) + "(int a) { return a * 2; }\n";
+
+        vector<string> sources;
+        for (int i = 0; i < 200; i++) {
+            sources.push_back(i % 10 == 0 ? large + "// " + to_string(i) : "int v" + to_string(i) + ";");
+        }
+
+        int requests[2], responses[2];
+        if (pipe(requests) != 0 || pipe(responses) != 0) { cerr << "Fail: pipe" << endl; return false; }
+
+        int status = -1;
+        thread server([&]() {
+            status = serveStream(requests[0], responses[1], 4);
+            close(responses[1]);
+        });
+        thread writer([&]() {
+            for (const auto& source : sources) write_all(requests[1], request_frame(source));
+            close(requests[1]);
+        });
+        string output = read_until_eof(responses[0]);
+        writer.join();
+        server.join();
+        close(requests[0]);
+        close(responses[0]);
+
+        vector<LexResponse> parsed;
+        bool ok = check(parse_responses(output, parsed) && parsed.size() == sources.size(), "one response per request");
+        bool in_order = ok;
+        for (size_t i = 0; in_order && i < sources.size(); i++) {
+            in_order = parsed[i].exit_code == 0 && parsed[i].out == expected_dump(sources[i]);
+        }
+        ok &= check(in_order, "responses in request order");
+        ok &= check(status == 0, "stream finished cleanly");
+
+        // A truncated frame is reported as malformed
+        if (pipe(requests) != 0 || pipe(responses) != 0) { cerr << "Fail: pipe" << endl; return false; }
+        write_all(requests[1], "SOURCE 100 0\nint x;");
+        close(requests[1]);
+        ok &= check(serveStream(requests[0], responses[1], 1) == 65, "truncated frame gives 65");
+        close(requests[0]);
+        close(responses[0]);
+        close(responses[1]);
+        return ok;
+    });
+
+    // Test 4: runServer() on a real socket: idle clients don't block others,
+    // the read timeout, shutdown and socket path checks. Waits use generous
+    // bounds so a loaded machine can't fail them; only a hang does.
+    run_test_block("Socket Server", [&]() {
+        string socket_path = "/tmp/c--_server_test_" + to_string(getpid()) + ".sock";
+        bool ok = true;
+
+        // Refuses to replace a regular file
+        {
+            ofstream victim(socket_path);
+            victim << "keep me";
+        }
+        ok &= check(runServer(socket_path, 1) == 73 && read_file(socket_path) == "keep me",
+                    "regular file at socket path is left alone");
+        unlink(socket_path.c_str());
+
+        // One worker and a read timeout far longer than the test
+        future<int> server = async(launch::async, [&]() { return runServer(socket_path, 1, 600000); });
+        int idle_fd = wait_for_server(socket_path);
+        if (idle_fd < 0) {
+            cerr << "Fail: server did not start" << endl;
+            requestServerStop();
+            return false;
+        }
+
+        // An idle client and a half-sent frame must not block other clients
+        int partial_fd = connect_to(socket_path);
+        write_all(partial_fd, "SOURCE 100 0\nint");
+
+        string path = "tests/sample_programs/arithmetic.c--";
+        stringstream captured;
+        streambuf* saved = cout.rdbuf(captured.rdbuf());
+        int client_status = runClient(socket_path, path, false);
+        cout.rdbuf(saved);
+        ok &= check(client_status == 0 && captured.str() == expected_dump(read_file(path)),
+                    "runClient round trip with idle connections open");
+
+        // The standalone client (build/c-like-client) prints exactly what runClient() does
+        captured.str("");
+        saved = cout.rdbuf(captured.rdbuf());
+        runClient(socket_path, path, true);
+        cout.rdbuf(saved);
+        string client_output;
+        int client_exit = run_command("build/c-like-client " + socket_path + " --index " + path, client_output);
+        ok &= check(client_exit == 0 && client_output == captured.str(), "c-like-client --index round trip");
+        client_exit = run_command("build/c-like-client " + socket_path + " tests/no_such_file.c-- 2>/dev/null", client_output);
+        ok &= check(client_exit == 66 && client_output.empty(), "c-like-client missing file gives 66");
+
+        ok &= check(runServer(socket_path, 1) == 73, "second server on a live socket is refused");
+
+        // Stopping does not wait for the connected clients
+        requestServerStop();
+        bool stopped = server.wait_for(chrono::seconds(30)) == future_status::ready;
+        if (!stopped) {
+            cerr << "FAIL: server did not stop with clients connected" << endl;
+            exit(1); // The server thread is stuck; joining it would hang the test run
+        }
+        ok &= check(server.get() == 0, "stop with clients connected");
+        ok &= check(!path_exists(socket_path), "socket file removed on stop");
+        close(idle_fd);
+        close(partial_fd);
+
+        // A short read timeout closes a connection that sends nothing
+        server = async(launch::async, [&]() { return runServer(socket_path, 1, 100); });
+        idle_fd = wait_for_server(socket_path);
+        if (idle_fd < 0) {
+            cerr << "Fail: server did not restart" << endl;
+            requestServerStop();
+            return false;
+        }
+        timeval limit = {30, 0};
+        setsockopt(idle_fd, SOL_SOCKET, SO_RCVTIMEO, &limit, sizeof(limit));
+        char byte;
+        ok &= check(read(idle_fd, &byte, 1) == 0, "idle connection closed after the read timeout");
+        close(idle_fd);
+        requestServerStop();
+        ok &= check(server.get() == 0, "restarted server stops cleanly");
+        return ok;
+    });
+
+    if (all_tests_passed) {
+        cout << "\n=== ALL SERVER TESTS PASSED ===\n" << endl;
+    } else {
+        cerr << "\n!!! SOME SERVER TESTS FAILED !!!\n" << endl;
+        exit(1);
+    }
+}
+
+
+int main() {
+    run_server_tests();
+    return 0;
+}
@@ -0,0 +1,11 @@
+// Must NOT compile: `make test` checks that LEX_STATIC rejects a lexical error
+// even when the result is not declared constexpr, and that the compiler output
+// names the error kind, line and column (the '@' on line 2, col 5).
+// Expected error: lexical error in embedded C-- snippet
+// Expected error: StaticLexError Error = STATIC_LEX_UNEXPECTED_CHARACTER; int Line = 2; int Column = 5
+#include "../src/StaticLexer.h"
+
+int main() {
+    auto tokens = LEX_STATIC("int y;\nint @x;");
+    return static_cast<int>(tokens.size());
+}
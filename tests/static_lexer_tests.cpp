@@ -0,0 +1,178 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <functional>
+#include <stdexcept>
+
+#include "../src/Lexer.h"
+#include "../src/Token.h"
+#include "../src/StaticLexer.h"
+
+using namespace std;
+
+extern bool had_lexer_error; // From Lexer.cpp
+
+// These snippets are lexed by the C++ compiler; a lexical error here fails the build
+// (static_lexer_compile_fail.cpp checks that it really does).
+constexpr auto kDeclTokens = LEX_STATIC("int x; x = 10;");
+static_assert(kDeclTokens.size() == 8, "int x ; x = 10 ; EOF");
+static_assert(kDeclTokens[0].type == KEYWORD_INT, "first token is 'int'");
+static_assert(kDeclTokens[5].type == NUMBER && kDeclTokens[5].literal_value == 10, "10 is a NUMBER");
+static_assert(kDeclTokens.value(kDeclTokens[1]) == "x", "lexeme of the identifier");
+static_assert(kDeclTokens[7].type == EOF_TOKEN && kDeclTokens[7].column == 15, "EOF column matches Lexer");
+
+constexpr auto kFunctionTokens = LEX_STATIC(R"(
+// Embedded kernel
+void calculate(int a[], int n) {
+    while (n >= 1) { if (a[n] != 0) { output a[n]; } n = n - 1; }
+    return;
+}
+)");
+
+// Helper to run a string through the runtime lexer and return tokens
+vector<Token> tokenize_string(const string& source) {
+    had_lexer_error = false; // Reset global error flag before each test
+    Lexer lexer(source);
+    return lexer.tokenize();
+}
+
+// Compares the compile-time tokens against Lexer::tokenize() on the same text
+template <size_t N>
+bool assert_same_tokens(const StaticTokenArray<N>& static_tokens, const string& source,
+                        const string& test_case_name) {
+    cout << "  Testing " << test_case_name << "... ";
+    vector<Token> runtime_tokens = tokenize_string(source);
+    vector<Token> converted = static_tokens.toTokens();
+
+    if (had_lexer_error) {
+        cerr << "FAIL: " << test_case_name << " (runtime lexer reported errors)" << endl;
+        return false;
+    }
+    if (runtime_tokens.size() != converted.size()) {
+        cerr << "FAIL: " << test_case_name << " (token count " << converted.size()
+             << ", runtime " << runtime_tokens.size() << ")" << endl;
+        return false;
+    }
+    for (size_t i = 0; i < runtime_tokens.size(); i++) {
+        // toString() covers type, lexeme, literal value, line and column
+        if (runtime_tokens[i].toString() != converted[i].toString()) {
+            cerr << "FAIL: " << test_case_name << " (token " << i << ")" << endl;
+            cerr << "  Expected: " << runtime_tokens[i].toString() << endl;
+            cerr << "  Actual:   " << converted[i].toString() << endl;
+            return false;
+        }
+    }
+    cout << "PASS" << endl;
+    return true;
+}
+
+// Same comparison, but running lexStaticInto() at runtime on arbitrary text
+bool assert_same_tokens_runtime(const string& source, const string& test_case_name) {
+    StaticTokenArray<512> static_tokens;
+    lexStaticInto(static_tokens, source.c_str(), source.size());
+    return assert_same_tokens(static_tokens, source, test_case_name);
+}
+
+void run_static_lexer_tests() {
+    cout << "--- Running Static Lexer Tests ---" << endl;
+    bool all_tests_passed = true;
+
+    auto run_test_block = [&](const string& name, const function<bool()>& test_func) {
+        cout << "\nTest Block: " << name << endl;
+        bool block_passed = test_func();
+        if (block_passed) {
+            cout << "SUCCESS: All tests in '" << name << "' block passed." << endl;
+        } else {
+            cout << "FAILURE: Some tests in '" << name << "' block failed." << endl;
+            all_tests_passed = false;
+        }
+        return block_passed;
+    };
+
+    // Test 1: Compile-time tokens match the runtime lexer
+    run_test_block("Compile-Time vs Runtime", [&]() {
+        bool ok = true;
+        ok &= assert_same_tokens(kDeclTokens, "int x; x = 10;", "declaration snippet");
+        ok &= assert_same_tokens(kFunctionTokens, R"(
+// Embedded kernel
+void calculate(int a[], int n) {
+    while (n >= 1) { if (a[n] != 0) { output a[n]; } n = n - 1; }
+    return;
+}
+)", "function snippet");
+        return ok;
+    });
+
+    // Test 2: The same scanner run at runtime agrees with Lexer on every token class
+    run_test_block("Runtime Path", [&]() {
+        bool ok = true;
+        ok &= assert_same_tokens_runtime("int void if else while return input output", "keywords");
+        ok &= assert_same_tokens_runtime("+ - * / = == != < <= > >=", "operators");
+        ok &= assert_same_tokens_runtime("{ } ( ) [ ] ; ,", "delimiters");
+        ok &= assert_same_tokens_runtime("0 123 2147483647 myVar _name_ f1x", "literals & identifiers");
+        ok &= assert_same_tokens_runtime("\tx = 1; // trailing comment\r\n\n  y", "whitespace & comments");
+        ok &= assert_same_tokens_runtime("", "empty source");
+        return ok;
+    });
+
+    // Test 3: Lexical errors throw at runtime with the runtime Lexer's first error message
+    run_test_block("Error Handling", [&]() {
+        bool ok = true;
+        const vector<string> sources = {
+            "int @x;",
+            "a\n  ! b",
+            "x = 2147483648;",
+            "y = 99999999999999999999 + 1;",
+            "int a;\n\tb = $;",
+        };
+        for (const auto& source : sources) {
+            vector<string> runtime_errors;
+            Lexer lexer(source);
+            lexer.setErrorSink(&runtime_errors);
+            lexer.tokenize();
+            if (runtime_errors.empty()) {
+                cerr << "FAIL: runtime lexer accepted '" << source << "'" << endl;
+                ok = false;
+                continue;
+            }
+            cout << "  Testing '" << runtime_errors[0] << "'... ";
+            try {
+                StaticTokenArray<32> tokens;
+                lexStaticInto(tokens, source.c_str(), source.size());
+                cerr << "FAIL: no error for '" << source << "'" << endl;
+                ok = false;
+            } catch (const invalid_argument& e) {
+                if (e.what() == runtime_errors[0]) {
+                    cout << "PASS" << endl;
+                } else {
+                    cerr << "FAIL: got '" << e.what() << "'" << endl;
+                    ok = false;
+                }
+            }
+        }
+
+        cout << "  Testing capacity overflow is reported... ";
+        try {
+            StaticTokenArray<2> tokens;
+            lexStaticInto(tokens, "a b", 3);
+            cerr << "FAIL: no error" << endl;
+            ok = false;
+        } catch (const invalid_argument&) {
+            cout << "PASS" << endl;
+        }
+        return ok;
+    });
+
+    if (all_tests_passed) {
+        cout << "\n=== ALL STATIC LEXER TESTS PASSED ===\n" << endl;
+    } else {
+        cerr << "\n!!! SOME STATIC LEXER TESTS FAILED !!!\n" << endl;
+        exit(1);
+    }
+}
+
+
+int main() {
+    run_static_lexer_tests();
+    return 0;
+}
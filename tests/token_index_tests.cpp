@@ -0,0 +1,190 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <functional>
+
+#include "../src/Lexer.h"
+#include "../src/Token.h"
+#include "../src/TokenIndex.h"
+
+using namespace std;
+
+extern bool had_lexer_error; // From Lexer.cpp
+
+// Helper to run a string through the lexer, filling `index`
+vector<Token> tokenize_with_index(const string& source, TokenIndex& index) {
+    had_lexer_error = false; // Reset global error flag before each test
+    Lexer lexer(source, &index);
+    return lexer.tokenize();
+}
+
+// Reference answer: linear scan comparing Token::value
+vector<size_t> scan_occurrences(const vector<Token>& tokens, const string& name) {
+    vector<size_t> result;
+    for (size_t i = 0; i < tokens.size(); i++) {
+        if (tokens[i].type == IDENTIFIER && tokens[i].value == name) result.push_back(i);
+    }
+    return result;
+}
+
+bool assert_occurrences(const TokenIndex& index, const vector<Token>& tokens, const string& name,
+                        const string& test_case_name) {
+    cout << "  Testing " << test_case_name << " - occurrences of '" << name << "'... ";
+    vector<size_t> expected = scan_occurrences(tokens, name);
+    vector<size_t> actual = index.occurrences(name);
+    if (actual == expected && index.occurrenceCount(name) == expected.size()) {
+        cout << "PASS" << endl;
+        return true;
+    }
+    cerr << "FAIL: " << test_case_name << " - '" << name << "': expected " << expected.size()
+         << " occurrences, got " << actual.size() << endl;
+    return false;
+}
+
+bool assert_count(const TokenIndex& index, TokenType type, size_t expected, const string& test_case_name) {
+    cout << "  Testing " << test_case_name << " - count of " << tokenTypeToString(type) << "... ";
+    if (index.count(type) == expected) {
+        cout << "PASS" << endl;
+        return true;
+    }
+    cerr << "FAIL: " << test_case_name << " - expected " << expected << ", got " << index.count(type) << endl;
+    return false;
+}
+
+void run_token_index_tests() {
+    cout << "--- Running Token Index Tests ---" << endl;
+    bool all_tests_passed = true;
+
+    auto run_test_block = [&](const string& name, const function<bool()>& test_func) {
+        cout << "\nTest Block: " << name << endl;
+        bool block_passed = test_func();
+        if (block_passed) {
+            cout << "SUCCESS: All tests in '" << name << "' block passed." << endl;
+        } else {
+            cout << "FAILURE: Some tests in '" << name << "' block failed." << endl;
+            all_tests_passed = false;
+        }
+        return block_passed;
+    };
+
+    // Test 1: Posting lists and per-type counts
+    run_test_block("Occurrences & Counts", [&]() {
+        string source = "int x; int y;\nx = y + 1;\nwhile (x) { y = x - 1; }";
+        TokenIndex index;
+        vector<Token> tokens = tokenize_with_index(source, index);
+        if (had_lexer_error) { cerr << "Fail: Lexical errors detected." << endl; return false; }
+
+        bool ok = true;
+        ok &= assert_occurrences(index, tokens, "x", "Small source");
+        ok &= assert_occurrences(index, tokens, "y", "Small source");
+        ok &= assert_occurrences(index, tokens, "missing", "Small source");
+        ok &= assert_count(index, KEYWORD_INT, 2, "Small source");
+        ok &= assert_count(index, IDENTIFIER, 7, "Small source");
+        ok &= assert_count(index, EOF_TOKEN, 1, "Small source");
+
+        cout << "  Testing Small source - distinct identifiers... ";
+        if (index.distinctIdentifiers() == 2) { cout << "PASS" << endl; } else { cerr << "FAIL: expected 2" << endl; ok = false; }
+        return ok;
+    });
+
+    // Test 2: Gaps that need multi-byte varints
+    run_test_block("Large Gaps", [&]() {
+        string source = "rare ";
+        for (int i = 0; i < 20000; i++) {
+            source += "a" + to_string(i % 7) + " ";
+            if (i % 5000 == 0) source += "rare ";
+        }
+        source += "rare";
+        TokenIndex index;
+        vector<Token> tokens = tokenize_with_index(source, index);
+        if (had_lexer_error) { cerr << "Fail: Lexical errors detected." << endl; return false; }
+
+        bool ok = true;
+        ok &= assert_occurrences(index, tokens, "rare", "Large gaps");
+        ok &= assert_occurrences(index, tokens, "a3", "Large gaps");
+        return ok;
+    });
+
+    // Test 3: write()/read() round trip, and re-tokenizing resets the index
+    run_test_block("Serialization", [&]() {
+        string source = "void f(int a) { output a; }\nint g(void) { f(g); return g; }";
+        TokenIndex index;
+        vector<Token> tokens = tokenize_with_index(source, index);
+        if (had_lexer_error) { cerr << "Fail: Lexical errors detected." << endl; return false; }
+
+        stringstream text;
+        index.write(text);
+        TokenIndex loaded;
+        bool ok = true;
+        cout << "  Testing read() accepts write() output... ";
+        if (TokenIndex::read(text, loaded)) { cout << "PASS" << endl; } else { cerr << "FAIL: read() rejected the dump" << endl; return false; }
+
+        for (const string name : {"f", "a", "g"}) {
+            ok &= assert_occurrences(loaded, tokens, name, "Round trip");
+        }
+        ok &= assert_count(loaded, DELIM_LBRACE, 2, "Round trip");
+
+        stringstream rewritten;
+        loaded.write(rewritten);
+        cout << "  Testing dump is stable... ";
+        if (rewritten.str() == text.str()) { cout << "PASS" << endl; } else { cerr << "FAIL: dumps differ" << endl; ok = false; }
+
+        Lexer lexer("a", &index);
+        lexer.tokenize();
+        ok &= assert_count(index, IDENTIFIER, 1, "Re-tokenize");
+        return ok;
+    });
+
+    // Test 4: read() rejects anything write() would not produce
+    run_test_block("Malformed Input", [&]() {
+        const string counts = "count IDENTIFIER 3\n";
+        cout << "  Testing well-formed baseline is accepted... ";
+        TokenIndex loaded;
+        {
+            istringstream in("index 2\n" + counts + "ident a 2 0 4\nident b 1 2\nend\n");
+            if (TokenIndex::read(in, loaded)) { cout << "PASS" << endl; } else { cerr << "FAIL: baseline rejected" << endl; return false; }
+        }
+
+        const struct { string text; const char* name; } cases[] = {
+            {"index 1\ncount IDENTIFIER 3\nident a 2 0 4\nident a 1 9\nend\n", "duplicate ident line"},
+            {"index 1\ncount IDENTIFIER 2\nident a 2 3 0\nend\n", "zero gap after the first occurrence"},
+            {"index 1\ncount IDENTIFIER 1\nident a 1 0 7\nend\n", "extra gap on an ident line"},
+            {"index 1\ncount IDENTIFIER 1 x\nident a 1 0\nend\n", "extra field on a count line"},
+            {"index 1 2\ncount IDENTIFIER 1\nident a 1 0\nend\n", "extra field on the header"},
+            {"index 1\ncount IDENTIFIER 1\nident a 1 0\nend now\n", "extra field after end"},
+            {"index 2\ncount IDENTIFIER 2\nident b 1 0\nident a 1 1\nend\n", "ident lines out of order"},
+            {"index 1\ncount IDENTIFIER 1\ncount IDENTIFIER 1\nident a 1 0\nend\n", "duplicate count line"},
+            {"index 1\ncount IDENTIFIER 1\nident a 1 -1\nend\n", "negative gap"},
+            {"index 1\ncount IDENTIFIER 1\nident a 0\nend\n", "ident without occurrences"},
+            {"index 1\ncount IDENTIFIER 5\nident a 1 0\nend\n", "IDENTIFIER count disagrees with occurrences"},
+            {"index 1\nident a 1 0\ncount IDENTIFIER 1\nend\n", "count after ident"},
+            {"index 1\ncount IDENTIFIER 1\nident a 1 0\n", "missing end"},
+        };
+        bool ok = true;
+        for (const auto& test_case : cases) {
+            cout << "  Testing rejects " << test_case.name << "... ";
+            istringstream in(test_case.text);
+            if (!TokenIndex::read(in, loaded)) {
+                cout << "PASS" << endl;
+            } else {
+                cerr << "FAIL: accepted " << test_case.name << endl;
+                ok = false;
+            }
+        }
+        return ok;
+    });
+
+    if (all_tests_passed) {
+        cout << "\n=== ALL TOKEN INDEX TESTS PASSED ===\n" << endl;
+    } else {
+        cerr << "\n!!! SOME TOKEN INDEX TESTS FAILED !!!\n" << endl;
+        exit(1);
+    }
+}
+
+
+int main() {
+    run_token_index_tests();
+    return 0;
+}